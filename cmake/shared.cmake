@@ -73,6 +73,16 @@ function (dyninst_library target)
     DESTINATION "${INSTALL_CMAKE_DIR}")
 endfunction()
 
+# A component test, built with BUILD_TESTS: <component>/tests/<name>/main.C
+# linked against the given libraries. By default it checks its own
+# executable; add_test further runs for other inputs. It fails by
+# exiting non-zero.
+function (dyninst_test name)
+  add_executable (test_${name} ${name}/main.C)
+  target_link_libraries (test_${name} ${ARGN})
+  add_test (NAME ${name} COMMAND test_${name} $<TARGET_FILE:test_${name}>)
+endfunction()
+
 
 
 #Change to switch between libiberty/libstdc++ demangler
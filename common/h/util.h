@@ -257,7 +257,7 @@ COMMON_EXPORT std::string utos(unsigned);
 
 COMMON_EXPORT bool wildcardEquiv(const std::string &us, const std::string &them, bool checkCase = false );
 
-const char *platform_string();
+COMMON_EXPORT const char *platform_string();
 }
 
 #endif
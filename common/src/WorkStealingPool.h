@@ -0,0 +1,109 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(WORK_STEALING_POOL_H_)
+#define WORK_STEALING_POOL_H_
+
+#include <deque>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "util.h"
+
+namespace Dyninst {
+
+/*
+ * A fixed-size pool of worker threads with one task deque per
+ * worker. Tasks submitted from a worker go to the back of that
+ * worker's deque and are popped LIFO, which keeps recursive work
+ * (e.g. a function and the callees it discovers) on the same thread;
+ * idle workers steal the oldest task from the front of a sibling's
+ * deque.
+ *
+ * Tasks are heap-allocated by the submitter and deleted by the pool
+ * once they have run.
+ */
+class COMMON_EXPORT WorkStealingPool {
+ public:
+    class Task {
+     public:
+        virtual ~Task() { }
+        virtual void run(WorkStealingPool & pool) = 0;
+    };
+
+    // 0 selects one worker per hardware thread
+    WorkStealingPool(unsigned num_workers = 0);
+    ~WorkStealingPool();
+
+    void submit(Task * t);
+
+    // Block until every submitted task (including those submitted
+    // by running tasks) has completed
+    void wait();
+
+    unsigned size() const { return (unsigned) workers_.size(); }
+
+    // Index of the calling worker in this pool, or -1 if the
+    // caller is not one of its workers
+    int worker_id() const;
+
+    static unsigned default_size();
+
+ private:
+    struct queue_t {
+        boost::mutex lock;
+        std::deque<Task *> tasks;
+    };
+
+    void worker_main(unsigned id);
+    Task * take(unsigned id);
+
+    std::vector<queue_t *> queues_;
+    std::vector<boost::thread *> workers_;
+
+    // guards pending_, outstanding_ and shutdown_
+    boost::mutex state_lock_;
+    boost::condition_variable work_cv_;
+    boost::condition_variable done_cv_;
+    unsigned long pending_;     // queued, not yet taken
+    unsigned long outstanding_; // queued or running
+    bool shutdown_;
+    unsigned next_queue_;
+
+    WorkStealingPool(const WorkStealingPool &);
+    WorkStealingPool & operator=(const WorkStealingPool &);
+};
+
+}
+
+#endif
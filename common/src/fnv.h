@@ -0,0 +1,74 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(FNV_H_)
+#define FNV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Dyninst {
+
+/*
+ * 64-bit FNV-1a, for cheap signatures and cache keys. Not suitable
+ * where an adversary controls the input.
+ *
+ * mix() folds in a whole value at once rather than byte by byte; it
+ * is faster and good enough to tell CFG shapes apart, but the two
+ * are not interchangeable.
+ */
+class FNVHash {
+ public:
+    FNVHash() : _h(14695981039346656037ULL) { }
+
+    void mix(uint64_t v)
+    {
+        _h = (_h ^ v) * prime;
+    }
+
+    void mix_bytes(const void * data, size_t len)
+    {
+        const unsigned char * p = (const unsigned char *) data;
+        for (size_t i = 0; i < len; ++i) {
+            _h ^= p[i];
+            _h *= prime;
+        }
+    }
+
+    uint64_t value() const { return _h; }
+
+ private:
+    static const uint64_t prime = 1099511628211ULL;
+    uint64_t _h;
+};
+
+}
+
+#endif
@@ -344,6 +344,12 @@ public:
   // prior results from the Graph
   // are substituted into anything that uses them.
   DATAFLOW_EXPORT static Retval_t expand(Dyninst::Graph::Ptr slice, DataflowAPI::Result_t &res);
+
+  // Expansions of instructions are cached, by address and instruction
+  // bytes, for every caller and thread. The least recently used ones are
+  // evicted once the cache holds about maxBytes; 0 disables caching.
+  DATAFLOW_EXPORT static void setExpansionCacheSize(size_t maxBytes);
+  DATAFLOW_EXPORT static void clearExpansionCache();
   
  private:
 
@@ -51,18 +51,46 @@ struct livenessData{
 	bitArray in, out, use, def;
 };
 
+// What a call to a function may read before writing, and what it may
+// write, including through the functions it calls
+struct livenessSummary{
+	bitArray read, clobber;
+};
+
 class DATAFLOW_EXPORT LivenessAnalyzer{
 	std::map<ParseAPI::Block*, livenessData> blockLiveInfo;
 	std::map<ParseAPI::Function*, bool> liveFuncCalculated;
         std::map<ParseAPI::Function*, bitArray> funcRegsDefined;
 	InstructionCache cachedLivenessInfo;
+	std::map<ParseAPI::Function*, livenessSummary> funcSummaries;
+	// The function called or tail called at the end of a block; NULL
+	// if there is no single known callee
+	std::map<ParseAPI::Block*, ParseAPI::Function*> callTargets;
+	// The functions found calling each function, so that clean() can
+	// drop the results that were computed from its summary
+	std::map<ParseAPI::Function*, std::set<ParseAPI::Function*> > callers;
 
 	const bitArray& getLivenessIn(ParseAPI::Block *block);
-	const bitArray& getLivenessOut(ParseAPI::Block *block, bitArray &allRegsDefined);
-	void processEdgeLiveness(ParseAPI::Edge* e, livenessData& data, ParseAPI::Block* block, const bitArray& allRegsDefined);
-	
-	void summarizeBlockLivenessInfo(ParseAPI::Function* func, ParseAPI::Block *block, bitArray &allRegsDefined);
-	bool updateBlockLivenessInfo(ParseAPI::Block *block, bitArray &allRegsDefined);
+
+	void summarizeBlockLivenessInfo(ParseAPI::Function* func, ParseAPI::Block *block, livenessData &data,
+					bitArray &allRegsDefined, InstructionCache &cache);
+	class AnalyzeTask;
+	struct func_liveness;
+
+	void findCallees(ParseAPI::Function *func, std::vector<ParseAPI::Function*> &callees);
+	void callGraphSCCs(const std::vector<ParseAPI::Function*> &roots,
+			   std::map<ParseAPI::Function*, std::vector<ParseAPI::Function*> > &callees,
+			   std::vector<std::vector<ParseAPI::Function*> > &sccs,
+			   unsigned maxDepth,
+			   std::set<ParseAPI::Function*> *truncated = NULL);
+	void computeSummaries(ParseAPI::Function *func, func_liveness &res,
+			      std::vector<ParseAPI::Function*> &partial);
+	void summarizeSCC(const std::vector<ParseAPI::Function*> &scc, bool recursive,
+			  func_liveness *keep = NULL);
+	void summarizeFunction(ParseAPI::Function *func, livenessSummary &summary,
+			       func_liveness &res);
+	const livenessSummary *calleeSummary(ParseAPI::Block *block) const;
+	class SummarizeTask;
 	
 	ReadWriteInfo calcRWSets(Instruction::Ptr curInsn, ParseAPI::Block* blk, Address a);
 
@@ -78,6 +106,9 @@ public:
 	typedef enum {Invalid_Location} ErrorType;
 	LivenessAnalyzer(int w);
 	void analyze(ParseAPI::Function *func);
+	// Analyzes every function of co that has not been analyzed yet,
+	// on up to num_threads threads (0 for one per hardware thread)
+	void analyze(ParseAPI::CodeObject *co, unsigned num_threads = 0);
 
 	template <class OutputIterator>
 	bool query(ParseAPI::Location loc, Type type, OutputIterator outIter){
@@ -97,6 +128,8 @@ public:
 
 	ErrorType getLastError(){ return errorno; }
 
+	// Drops the results for func and for every function whose results
+	// depend on what func does when called
 	void clean(ParseAPI::Function *func);
 	void clean();
 
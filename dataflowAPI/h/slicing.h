@@ -132,6 +132,8 @@ class SliceEdge : public Edge {
    AbsRegion data_;
 };
 
+class SliceContext;
+
 class Slicer {
  public:
   typedef std::pair<InstructionPtr, Address> InsnInstance;
@@ -142,6 +144,13 @@ class Slicer {
 	 ParseAPI::Function *func,
 	 bool cache = true,
 	 bool stackAnalysis = true);
+
+  // Decoded instructions and their assignments come from (and are
+  // left in) context, which must outlive the slicer
+  DATAFLOW_EXPORT Slicer(AssignmentPtr a,
+	 ParseAPI::Block *block,
+	 ParseAPI::Function *func,
+	 SliceContext &context);
     
   DATAFLOW_EXPORT static bool isWidenNode(Node::Ptr n);
 
@@ -682,6 +691,9 @@ class Slicer {
   ParseAPI::Block *b_;
   ParseAPI::Function *f_;
 
+  // shared instruction and assignment cache, if any
+  SliceContext *context_;
+
 
   // Assignments map to unique slice nodes
   std::unordered_map<AssignmentPtr, SliceNode::Ptr, Assignment::AssignmentPtrHasher> created_;
@@ -718,6 +730,51 @@ class Slicer {
   std::set<ParseAPI::Edge*> visitedEdges;
 };
 
+/*
+ * The decoded instructions of each block and the assignments they
+ * convert to, shared by any number of slicers (see the Slicer
+ * constructor that takes a context). Tools that slice the same code
+ * over and over, such as jump table or stack frame analyses, decode
+ * and convert each block once instead of once per slice.
+ *
+ * Slicers on different threads may share a context. Entries are built
+ * once and not modified afterwards; building them is serialized.
+ * Assignments are converted a whole block at a time, for the function
+ * they are requested in, and each instruction always converts to the
+ * same Assignment objects.
+ *
+ * If a block changes (e.g., it is split by further parsing) its entry
+ * must be invalidated before slicing it again. Neither invalidate nor
+ * clear may be called while a slicer is using the context.
+ */
+class SliceContext {
+ public:
+  DATAFLOW_EXPORT SliceContext(bool stackAnalysis = true);
+  DATAFLOW_EXPORT ~SliceContext();
+
+  DATAFLOW_EXPORT void invalidate(ParseAPI::Block *block);
+  DATAFLOW_EXPORT void clear();
+
+ private:
+  friend class Slicer;
+
+  struct BlockEntry;
+  struct Impl;
+
+  SliceContext(const SliceContext &);
+  SliceContext &operator=(const SliceContext &);
+
+  BlockEntry *entry(ParseAPI::Block *block);
+  Slicer::InsnVec &insns(ParseAPI::Block *block);
+  void convert(InstructionPtr insn,
+               Address addr,
+               ParseAPI::Function *func,
+               ParseAPI::Block *block,
+               std::vector<AssignmentPtr> &ret);
+
+  Impl *impl_;
+};
+
 }
 
 #endif
@@ -39,6 +39,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 // To define StackAST
 #include "DynAST.h"
@@ -334,9 +335,27 @@ public:
    typedef std::map<ParseAPI::Block *, std::map<Offset, TransferFuncs>>
       InstructionEffects;
 
+   // Stack and frame pointer heights at each instruction of a function,
+   // kept as sorted arrays; see analyzeFunctions
+   struct HeightTable;
+
    DATAFLOW_EXPORT StackAnalysis();
    DATAFLOW_EXPORT StackAnalysis(ParseAPI::Function *f);
 
+   // Analyzes funcs on up to num_threads threads (0 for one per hardware
+   // thread) and annotates each function with a HeightTable. findSP and
+   // findFP answer from the table by binary search and never analyze or
+   // modify it, so once a function has one they may be called for it
+   // from any number of threads.
+   DATAFLOW_EXPORT static void analyzeFunctions(
+      const std::vector<ParseAPI::Function *> &funcs,
+      unsigned num_threads = 0);
+
+   // Frees every result cached on f (intervals, effects and the height
+   // table), so the next query analyzes f again. Must not race with
+   // queries on f.
+   DATAFLOW_EXPORT static void invalidate(ParseAPI::Function *f);
+
    DATAFLOW_EXPORT Height find(ParseAPI::Block *, Address addr, Absloc loc);
    DATAFLOW_EXPORT Height findSP(ParseAPI::Block *, Address addr);
    DATAFLOW_EXPORT Height findFP(ParseAPI::Block *, Address addr);
@@ -416,6 +435,10 @@ private:
 
    Height getStackCleanAmount(ParseAPI::Function *func);
 
+   class HeightsTask;
+   static HeightTable *computeHeights(ParseAPI::Function *f);
+   bool findHeight(ParseAPI::Block *b, Address addr, bool fp, Height &ret);
+
 
    ParseAPI::Function *func;
 
@@ -432,6 +455,10 @@ private:
    BlockSummaryState blockSummaryOutputs;
 
    Intervals *intervals_; // Pointer so we can make it an annotation
+   HeightTable *heights_; // Annotation, if the function has one
+
+   // Whether results are read from and saved to annotations
+   bool annotate;
 
    FuncCleanAmounts funcCleanAmounts;
    int word_size;
@@ -0,0 +1,144 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(_EXPANSION_CACHE_H_)
+#define _EXPANSION_CACHE_H_
+
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "dyn_regs.h"
+#include "DynAST.h"
+#include "../h/Absloc.h"
+
+namespace Dyninst {
+namespace DataflowAPI {
+
+/*
+ * Semantic expansions of instructions, kept so that expanding the same
+ * instruction again (as slicing-heavy analyses such as jump table
+ * resolution and stack tamper detection do constantly) skips the ROSE
+ * conversion and semantics.
+ *
+ * An expansion is keyed by the instruction's address and bytes and by
+ * the locations it was asked for, named as SymEvalPolicy names them
+ * (registers by themselves, memory as a single location). That is all
+ * an expansion depends on, so the cache is shared by every slice and
+ * every thread. It is split into shards, each with its own lock and
+ * least recently used list, and evicts expansions once it holds about
+ * its size limit.
+ *
+ * Consumers are free to modify the ASTs they get back in place, so the
+ * cache keeps its own copies of expansions and hands out copies.
+ */
+class ExpansionCache {
+ public:
+   struct Key {
+      Architecture arch;
+      Address addr;
+      std::string bytes;
+      std::vector<Absloc> outs;
+
+      bool operator==(const Key &rhs) const {
+         return addr == rhs.addr && arch == rhs.arch &&
+            bytes == rhs.bytes && outs == rhs.outs;
+      }
+   };
+
+   struct Value {
+      // the expansion of each of the key's outs; NULL if it was not written
+      std::vector<AST::Ptr> asts;
+      bool failed;
+   };
+
+   static const size_t DEFAULT_LIMIT = 32 * 1024 * 1024;
+
+   static ExpansionCache &instance();
+
+   // Fills val with a copy of the expansion cached for key
+   bool lookup(const Key &key, Value &val);
+   // Caches a copy of val, which the caller keeps
+   void insert(const Key &key, const Value &val);
+
+   // Approximate size limit in bytes; 0 disables caching
+   void setLimit(size_t bytes);
+   void clear();
+
+ private:
+   static const unsigned NUM_SHARDS = 16;
+
+   struct Entry {
+      Key key;
+      Value val;
+      size_t cost;
+   };
+   typedef std::list<Entry> LRU;
+
+   struct KeyHash {
+      size_t operator()(const Key *k) const;
+   };
+   struct KeyEq {
+      bool operator()(const Key *a, const Key *b) const { return *a == *b; }
+   };
+
+   struct Shard {
+      Shard() : bytes(0), limit(DEFAULT_LIMIT / NUM_SHARDS) {}
+
+      boost::mutex lock;
+      LRU lru; // most recently used first
+      std::unordered_map<const Key *, LRU::iterator, KeyHash, KeyEq> index;
+      size_t bytes;
+      size_t limit;
+
+      void evict();
+   };
+
+   ExpansionCache() {}
+   ExpansionCache(const ExpansionCache &);
+   ExpansionCache &operator=(const ExpansionCache &);
+
+   Shard &shard(const Key &key);
+
+   static void copy(const Value &from, Value &to);
+   static AST::Ptr copy(AST::Ptr ast, std::map<AST *, AST::Ptr> &copied);
+   static size_t cost(const Entry &e);
+
+   Shard shards_[NUM_SHARDS];
+};
+
+}
+}
+
+#endif
@@ -35,6 +35,7 @@
 #include "dyntypes.h"
 #include <map>
 #include <string>
+#include <vector>
 
 namespace Dyninst {
 class Elf_X;
@@ -61,6 +62,7 @@ class DYNDWARF_EXPORT DwarfHandle {
    Dwarf_Debug *line_data;
    Dwarf_Debug *type_data;
    Dwarf_Debug *frame_data;
+   std::vector<Dwarf_Debug *> extra_type_data;
 
    Elf_X *file;
    Elf_X *dbg_file;
@@ -87,6 +89,9 @@ class DYNDWARF_EXPORT DwarfHandle {
    Dwarf_Debug *line_dbg();
    Dwarf_Debug *type_dbg();
    Dwarf_Debug *frame_dbg();
+   // An additional, independent handle on the type information, for
+   // walking it from another thread. It lives as long as this handle.
+   Dwarf_Debug *newTypeDbg();
    DwarfFrameParserPtr frameParser();
 };
 
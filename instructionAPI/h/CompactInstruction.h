@@ -0,0 +1,160 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(COMPACT_INSTRUCTION_H)
+#define COMPACT_INSTRUCTION_H
+
+#include <stdint.h>
+
+#include "Instruction.h"
+#include "InstructionCategories.h"
+#include "InstructionDecoder.h"
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    /// A %CompactInstruction is the decoded form of one instruction as a small,
+    /// trivially copyable value: its opcode, length, raw bytes, category, the
+    /// displacement of a direct branch, and a packed descriptor (kind and
+    /// read/write flags) for each explicit operand.  It holds no pointers and
+    /// allocates nothing, so large numbers of them can be kept in plain arrays
+    /// and copied with \c memcpy.
+    ///
+    /// %CompactInstructions are produced by InstructionDecoder::decodeCompact.
+    /// Operand expressions are not built for them; when an analysis needs those,
+    /// \c instruction builds the equivalent %Instruction, whose operands are in
+    /// turn decoded on first use.
+    ///
+    /// Operand descriptors come from the decoding tables, and are available on
+    /// x86 and x86_64.  Other architectures report \c hasOperandInfo() as false.
+    class INSTRUCTION_EXPORT CompactInstruction
+    {
+      friend class InstructionDecoderImpl;
+      friend class InstructionDecoder_x86;
+    public:
+      enum OperandKind
+      {
+        NoOperand = 0,
+        RegisterOperand,
+        MemoryOperand,
+        ImmediateOperand,
+        RelativeOperand,
+        OtherOperand
+      };
+      static const unsigned int maxOperands = 4;
+
+      /// Constructs an invalid %CompactInstruction.
+      CompactInstruction();
+
+      /// Returns true if this object holds a decoded instruction.
+      bool isValid() const { return m_Size != 0; }
+
+      /// Returns true if the bytes decoded to a legal instruction.
+      bool isLegalInsn() const { return getID() != e_No_Entry; }
+
+      /// The opcode of the instruction.
+      entryID getID() const { return (entryID) m_ID; }
+
+      /// The category of the instruction, as returned by Instruction::getCategory.
+      InsnCategory getCategory() const { return (InsnCategory) m_Category; }
+
+      Architecture getArch() const { return m_Arch; }
+
+      /// The size of the instruction in bytes.
+      size_t size() const { return m_Size; }
+
+      /// The \c index th byte of the instruction.
+      unsigned char rawByte(unsigned int index) const;
+
+      /// A pointer to the bytes of the instruction.
+      const void* ptr() const { return m_Raw; }
+
+      /// \return True if this is a PC-relative jump, call or branch whose
+      /// displacement was recorded when it was decoded, as for
+      /// Instruction::getDirectTarget.
+      ///
+      /// \param addr The address of this instruction
+      /// \param target Set to the branch target
+      bool getDirectTarget(Address addr, Address& target) const;
+
+      /// Returns true if the operand descriptors below are filled in.
+      bool hasOperandInfo() const { return (m_Flags & hasOperandInfoFlag) != 0; }
+
+      /// The number of explicit operands, in the order of Instruction::getOperands.
+      /// Operands that the %Instruction adds implicitly, such as the stack pointer
+      /// of a push, are not described.
+      unsigned int numOperands() const { return m_NumOperands; }
+
+      /// The kind of operand \c i, or \c NoOperand if there is no such operand.
+      OperandKind getOperandKind(unsigned int i) const;
+
+      /// Whether operand \c i is read or written by the instruction.
+      bool isRead(unsigned int i) const;
+      bool isWritten(unsigned int i) const;
+
+      /// Builds the %Instruction for these bytes.  Its operands are decoded
+      /// lazily, as for any other %Instruction.
+      Instruction::Ptr instruction() const;
+
+    private:
+      enum
+      {
+        directCFFlag = 0x1,
+        hasOperandInfoFlag = 0x2
+      };
+      enum
+      {
+        operandKindMask = 0x3f,
+        operandReadFlag = 0x40,
+        operandWrittenFlag = 0x80
+      };
+
+      void setBytes(const unsigned char* raw, size_t size, size_t avail);
+      void setDirectTarget(int32_t displacement);
+      // records operand i (if there is room) and returns i + 1
+      unsigned int addOperand(unsigned int i, OperandKind kind, bool read, bool written);
+      void setNumOperands(unsigned int n);
+
+      // Plain data only: copies of this class must stay trivial
+      unsigned char m_Raw[InstructionDecoder::maxInstructionLength];
+      Architecture m_Arch;
+      int32_t m_Displacement;
+      uint16_t m_ID;
+      uint8_t m_Size;
+      uint8_t m_Category;
+      uint8_t m_Flags;
+      uint8_t m_NumOperands;
+      uint8_t m_Operands[maxOperands];
+    };
+  }
+}
+
+#endif //!defined(COMPACT_INSTRUCTION_H)
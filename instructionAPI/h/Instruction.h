@@ -237,6 +237,16 @@ namespace Dyninst
       /// More details about this may be found in Expression and Dereference.
       INSTRUCTION_EXPORT Expression::Ptr getControlFlowTarget() const;
 
+      /// \return True if this is a PC-relative jump, call or branch whose displacement
+      /// was recorded when it was decoded (currently on x86 and x86_64).
+      ///
+      /// \param addr The address of this instruction
+      /// \param target Set to the branch target
+      ///
+      /// This gives the value of \c getControlFlowTarget for \c PC = \c addr
+      /// without decoding the operands.
+      INSTRUCTION_EXPORT bool getDirectTarget(Address addr, Address& target) const;
+
       /// \return False if control flow will unconditionally go to the result of
       /// \c getControlFlowTarget after executing this instruction.
       INSTRUCTION_EXPORT bool allowsFallThrough() const;
@@ -265,7 +275,7 @@ namespace Dyninst
       /// and c_NoCategory, as defined in %InstructionCategories.h.
       INSTRUCTION_EXPORT InsnCategory getCategory() const;
 
-      typedef std::list<CFT>::const_iterator cftConstIter;
+      typedef std::vector<CFT>::const_iterator cftConstIter;
       INSTRUCTION_EXPORT cftConstIter cft_begin() const {
           return m_Successors.begin();
       }
@@ -283,13 +293,19 @@ namespace Dyninst
       void addSuccessor(Expression::Ptr e, bool isCall, bool isIndirect, bool isConditional, bool isFallthrough) const;
       void copyRaw(size_t size, const unsigned char* raw);
       Expression::Ptr makeReturnExpression() const;
-      mutable std::list<Operand> m_Operands;
+      mutable std::vector<Operand> m_Operands;
       Operation::Ptr m_InsnOp;
       bool m_Valid;
+      // operands and successors are filled in; decoding them again
+      // would append duplicates
+      mutable bool m_OperandsDecoded;
+      // PC-relative branch displacement, set by the decoder
+      bool m_DirectCF;
+      int32_t m_CFDisplacement;
       raw_insn_T m_RawInsn;
       unsigned int m_size;
       Architecture arch_decoded_from;
-      mutable std::list<CFT> m_Successors;
+      mutable std::vector<CFT> m_Successors;
       static int numInsnsAllocated;
 
     };
@@ -0,0 +1,122 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(INSTRUCTION_BATCH_H)
+#define INSTRUCTION_BATCH_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "Instruction.h"
+#include "InstructionCategories.h"
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4251)
+#endif
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    /// An %InstructionBatch holds the result of decoding a contiguous range of
+    /// bytes with InstructionDecoder::decodeBatch.  Each instruction is kept as
+    /// a small fixed-size record (offset, length and opcode) in a single array,
+    /// so decoding a range performs no per-instruction allocation.  A full
+    /// %Instruction, with its operands, is only built when \c instruction is
+    /// called for a particular record.
+    ///
+    /// Records refer to the bytes of the buffer that was decoded, which must
+    /// outlive the batch (or its next use).  Decoding into an existing batch
+    /// replaces its contents but keeps its storage, so a batch can be reused
+    /// across ranges without reallocating; destroying or clearing the batch
+    /// releases every record at once.
+    class INSTRUCTION_EXPORT InstructionBatch
+    {
+      friend class InstructionDecoder;
+    public:
+      InstructionBatch();
+
+      /// Removes all records, keeping the storage for reuse.
+      void clear();
+
+      /// Reserves storage for \c n records.
+      void reserve(size_t n);
+
+      /// The number of instructions in the batch.
+      size_t size() const { return m_Records.size(); }
+      bool empty() const { return m_Records.empty(); }
+
+      /// The architecture the batch was decoded as.
+      Architecture getArch() const { return m_Arch; }
+
+      /// The address of instruction \c i, relative to the \c base
+      /// address given to InstructionDecoder::decodeBatch.
+      Address address(size_t i) const { return m_Base + m_Records[i].offset; }
+
+      /// The length in bytes of instruction \c i.
+      size_t length(size_t i) const { return m_Records[i].length; }
+
+      /// A pointer to the bytes of instruction \c i.
+      const unsigned char* ptr(size_t i) const { return m_Buffer + m_Records[i].offset; }
+
+      /// The opcode of instruction \c i; \c e_No_Entry for invalid instructions.
+      entryID getID(size_t i) const { return (entryID) m_Records[i].id; }
+
+      /// Whether instruction \c i was decoded as a legal instruction.
+      bool isLegalInsn(size_t i) const { return getID(i) != e_No_Entry; }
+
+      /// The category of instruction \c i, as returned by Instruction::getCategory.
+      InsnCategory getCategory(size_t i) const;
+
+      /// Builds the %Instruction for record \c i.  Operands are decoded lazily,
+      /// as for any other %Instruction.
+      Instruction::Ptr instruction(size_t i) const;
+
+      /// The index of the instruction starting at \c addr, or \c size() if
+      /// no instruction in the batch starts there.
+      size_t find(Address addr) const;
+
+    private:
+      struct record
+      {
+          Offset offset;
+          uint32_t id;
+          uint8_t length;
+      };
+
+      std::vector<record> m_Records;
+      const unsigned char* m_Buffer;
+      Address m_Base;
+      Architecture m_Arch;
+    };
+  }
+}
+
+#endif //!defined(INSTRUCTION_BATCH_H)
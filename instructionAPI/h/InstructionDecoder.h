@@ -49,6 +49,8 @@ namespace Dyninst
     /// end is reached.  At that point, all subsequent calls to \c decode will return a null %Instruction pointer.
     ///
       class InstructionDecoderImpl;
+      class InstructionBatch;
+      class CompactInstruction;
 
     class INSTRUCTION_EXPORT InstructionDecoder
     {
@@ -72,6 +74,14 @@ namespace Dyninst
       /// a null %Instruction pointer will be returned.  The %Instruction's \c size field will contain
       /// the size of the instruction decoded.
       Instruction::Ptr decode(const unsigned char* buffer);
+      /// Decode the instructions from the current position to the end of this %InstructionDecoder object's
+      /// buffer into \c batch, replacing its contents.  \c base is the address of the current position and
+      /// is used to compute the addresses of the decoded instructions.  Decoding stops early at an instruction
+      /// that cannot be decoded or that runs past the end of the buffer.  Returns the number of instructions decoded.
+      size_t decodeBatch(InstructionBatch& batch, Address base = 0);
+      /// Decode the current instruction into \c insn, as \c decode would, but without building an
+      /// %Instruction or its %Operation.  Returns false, leaving \c insn invalid, at the end of the buffer.
+      bool decodeCompact(CompactInstruction& insn);
       void doDelayedDecode(const Instruction* insn_to_complete);
       struct INSTRUCTION_EXPORT buffer
       {
@@ -36,6 +36,7 @@
 #include "common/src/ia32_locations.h"
 
 namespace NS_x86 {
+struct ia32_entry;
 struct ia32_operand;
 class ia32_instruction;
 }
@@ -83,6 +84,8 @@ namespace Dyninst
                                       int & imm_index,
                                       const Instruction* insn_to_complete, bool isRead, bool isWritten);
                 virtual void decodeOpcode(InstructionDecoder::buffer& b);
+                virtual entryID decodeEntry(InstructionDecoder::buffer& b);
+                virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& insn);
       
                 Expression::Ptr makeSIBExpression(const InstructionDecoder::buffer& b);
                 Expression::Ptr makeModRMExpression(const InstructionDecoder::buffer& b,
@@ -93,7 +96,11 @@ namespace Dyninst
                 virtual Result_Type makeSizeType(unsigned int opType);
 
             private:
+                NS_x86::ia32_entry* doIA32DecodeEntry(InstructionDecoder::buffer& b);
                 void doIA32Decode(InstructionDecoder::buffer& b);
+                bool directDisplacement(NS_x86::ia32_entry* entry, const unsigned char* raw,
+                                        unsigned int size, int32_t& disp);
+                void describeOperands(NS_x86::ia32_entry* entry, CompactInstruction& insn);
 		bool isDefault64Insn();
 		
                 static TLS_VAR ia32_locations* locs;
@@ -37,6 +37,9 @@
 #include "entryIDs.h"
 #include "Instruction.h"
 #include "InstructionDecoder.h" // buffer...anything else?
+#include "CompactInstruction.h"
+
+#include <boost/thread/tss.hpp>
 
 namespace Dyninst
 {
@@ -52,6 +55,11 @@ class InstructionDecoderImpl
         virtual Instruction::Ptr decode(InstructionDecoder::buffer& b);
         virtual void doDelayedDecode(const Instruction* insn_to_complete) = 0;
         virtual void setMode(bool is64) = 0;
+        // decode the instruction at b.start and advance past it, returning only its opcode
+        virtual entryID decodeEntry(InstructionDecoder::buffer& b);
+        // decode the instruction at b.start into insn and advance past it
+        virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& insn);
+        Architecture getArch() const { return m_Arch; }
         static Ptr makeDecoderImpl(Architecture a);
 
     protected:
@@ -77,7 +85,8 @@ class InstructionDecoderImpl
     protected:
         Operation::Ptr m_Operation;
         Architecture m_Arch;
-        static std::map<Architecture, Ptr> impls;
+        typedef std::map<Architecture, Ptr> impl_map_t;
+        static boost::thread_specific_ptr<impl_map_t> impls;
       
 };
 
@@ -58,6 +58,7 @@ class LoopAnalyzer;
 class dominatorCFG;
 class CodeObject;
 class CFGModifier;
+class ParseCallbackManager;
 
 enum EdgeTypeEnum {
     CALL = 0,
@@ -640,6 +641,17 @@ class PARSER_EXPORT Function : public allocatable, public AnnotatableSparse {
     mutable std::map<Block*, std::set<Block*>*> immediatePostDominates;
     mutable std::map<Block*, Block*> immediatePostDominator;
 
+    /* Loop and dominator information describe the CFG as it was when
+       they were computed. Each time the block list is rebuilt, its
+       signature is compared with the one they were computed for, and
+       they are discarded only if the CFG actually changed, after the
+       callbacks have been told to drop what they built on them. */
+    uint64_t _analysis_sig;
+    uint64_t cfgSignature() const;
+    void updateAnalyses(ParseCallbackManager &pcb);
+    void invalidateAnalyses();
+    void ensureFinalized() const;
+
     /*** Internal parsing methods and state ***/
     void add_block(Block *b);
 
@@ -648,6 +660,7 @@ class PARSER_EXPORT Function : public allocatable, public AnnotatableSparse {
     friend class CFGFactory;
     friend class CodeObject;
     friend class dominatorCFG;
+    friend class region_data;
 };
 
 /* Describes a contiguous extent of a Function object */
@@ -75,6 +75,28 @@ class CodeObject {
     
     // `hint-based' parsing
     PARSER_EXPORT void parse();
+
+    // number of threads `hint-based' parsing and probabilistic gap
+    // parsing may use; 1 (the default) parses serially, 0 uses one
+    // thread per hardware thread. The resulting CFG is the same
+    // either way.
+    PARSER_EXPORT void setParseThreads(unsigned num_threads);
+
+    // load the result of `hint-based' parsing from, and save it to, a
+    // persistent per-binary cache when the CodeSource provides a cache
+    // key (see CodeSource::cacheKey). Off by default.
+    PARSER_EXPORT void setCFGCache(bool enable);
+
+    // once parsing is finalized, keep the address lookup structures in
+    // compact sorted arrays. Suits CodeObjects that change little after
+    // parsing. Off by default; ignored in defensive mode.
+    PARSER_EXPORT void setFlatLookups(bool enable);
+
+    // parse functions only as lookups (findFuncs, findBlocks, and
+    // friends) or Function::blocks() need them, instead of all at once
+    // on the first lookup. parse() still parses everything. Off by
+    // default.
+    PARSER_EXPORT void setLazyParsing(bool enable);
     
     // `exact-target' parsing; optinally recursive
     PARSER_EXPORT void parse(Address target, bool recursive);
@@ -101,6 +123,8 @@ class CodeObject {
 
     // functions
     PARSER_EXPORT Function * findFuncByEntry(CodeRegion * cr, Address entry);
+    // finds a function without parsing; safe while parsing is under way
+    PARSER_EXPORT Function * findCurrentFuncByEntry(CodeRegion * cr, Address entry);
     PARSER_EXPORT int findFuncs(CodeRegion * cr, 
             Address addr, 
             std::set<Function*> & funcs);
@@ -108,7 +132,7 @@ class CodeObject {
     PARSER_EXPORT int findFuncs(CodeRegion * cr,
             Address start, Address end,
             std::set<Function*> & funcs);
-    PARSER_EXPORT const funclist & funcs() { return flist; }
+    PARSER_EXPORT const funclist & funcs();
 
     // blocks
     PARSER_EXPORT Block * findBlockByEntry(CodeRegion * cr, Address entry);
@@ -162,6 +186,8 @@ class CodeObject {
     friend void Function::delayed_link_return(CodeObject *,Block*);
     // allows Functions to finalize (need Parser access)
     friend void Function::finalize();
+    // allows Blocks to finalize the functions that own them
+    friend class Block;
     // allows Function entry blocks to be moved to new regions
     friend void Function::setEntryBlock(Block *);
 
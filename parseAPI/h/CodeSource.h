@@ -34,6 +34,7 @@
 #include <vector>
 #include <utility>
 #include <string>
+#include <atomic>
 
 #include "Symtab.h"
 #include "IBSTree.h"
@@ -185,6 +186,14 @@ class PARSER_EXPORT CodeSource : public Dyninst::InstructionSource {
      */
     virtual Address getTOC(Address) const { return _table_of_contents; }
 
+    /* A string that identifies this code and the hints it supplies,
+       stable across runs (e.g., the ELF build-id for a
+       SymtabCodeSource). Enables the persistent CFG cache.
+
+       Optional.
+    */
+    virtual bool cacheKey(std::string & /*key*/) const { return false; }
+
     // statistics accessor
     virtual void print_stats() const { return; }
     virtual bool have_stats() const { return false; }
@@ -246,7 +255,8 @@ class PARSER_EXPORT SymtabCodeSource : public CodeSource {
  private:
     SymtabAPI::Symtab * _symtab;
     bool owns_symtab;
-    mutable CodeRegion * _lookup_cache;
+    // last region found by lookup_region; parse threads share it
+    mutable std::atomic<CodeRegion *> _lookup_cache;
 
     // Stats information
     StatContainer * stats_parse;
@@ -274,6 +284,7 @@ class PARSER_EXPORT SymtabCodeSource : public CodeSource {
     Address baseAddress() const;
     Address loadAddress() const;
     Address getTOC(Address addr) const;
+    bool cacheKey(std::string & key) const;
     SymtabAPI::Symtab * getSymtabObject() {return _symtab;} 
 
     /** InstructionSource implementation **/
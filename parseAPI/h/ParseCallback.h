@@ -156,6 +156,10 @@ class ParseCallback {
 
   virtual void modify_edge_cb(Edge *, Block *, ParseCallback::edge_type_t) {};
 
+  // The function's CFG changed; its loop and dominator information is
+  // freed once this returns
+  virtual void invalidate_analyses_cb(Function *) {};
+
   private:
 };
 
@@ -204,6 +208,7 @@ class ParseCallbackManager {
   bool hasWeirdInsns(const Function*);
   void foundWeirdInsns(Function*);
   void split_block_cb(Block *, Block *);
+  void invalidateAnalyses(Function *);
   
 
   private:
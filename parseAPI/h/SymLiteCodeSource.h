@@ -83,7 +83,8 @@ class SymReaderCodeSource : public CodeSource {
  private:
     SymReader * _symtab;
     bool owns_symtab;
-    mutable CodeRegion * _lookup_cache;
+    // last region found by lookup_region; parse threads share it
+    mutable std::atomic<CodeRegion *> _lookup_cache;
 
     // Stats information
     StatContainer * stats_parse;
@@ -0,0 +1,153 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _CFG_CACHE_H_
+#define _CFG_CACHE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "dyntypes.h"
+#include "dyn_regs.h"
+
+class MappedFile;
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * On-disk image of a finalized CFG.
+ *
+ * The file is a fixed header, the cache key, and then flat arrays of
+ * fixed-size records followed by a string table. Nothing needs to be
+ * decoded to read it: a loaded cache is simply the mapped file, with
+ * the record arrays read in place.
+ *
+ * Cache files live next to the SymtabAPI caches ($DYNINST_CACHE_DIR,
+ * or $HOME/.dyninstAPI/caches/<platform>) and are named after the key
+ * supplied by the CodeSource, so a stale file is never found for a
+ * rebuilt binary. Files that fail validation are removed.
+ */
+class CFGCache {
+ public:
+    struct region_rec {
+        uint64_t offset;
+        uint64_t length;
+    };
+    struct func_rec {
+        uint64_t addr;
+        uint64_t ret_addr;
+        uint32_t region;
+        uint32_t name;      // offset into the string table
+        uint32_t src;       // FuncSource
+        uint32_t retstatus; // FuncReturnStatus
+        uint32_t flags;     // FUNC_* below
+        uint32_t reserved;
+    };
+    enum {
+        FUNC_NO_STACK_FRAME = 0x1,
+        FUNC_SAVES_FP = 0x2,
+        FUNC_CLEANS_STACK = 0x4,
+        FUNC_LEAF = 0x8
+    };
+    struct block_rec {
+        uint64_t start;
+        uint64_t end;
+        uint64_t last;
+        uint32_t region;
+        uint32_t owner;     // index of a function containing the block
+    };
+    struct edge_rec {
+        uint32_t src;       // block indices
+        uint32_t trg;       // NO_BLOCK for sink edges
+        uint16_t type;      // EdgeTypeEnum
+        uint8_t sink;
+        uint8_t interproc;
+    };
+    static const uint32_t NO_BLOCK = 0xffffffff;
+
+    explicit CFGCache(const std::string & key);
+    ~CFGCache();
+
+    /** reading **/
+
+    // map and validate the cache file, if there is one
+    bool open(Architecture arch);
+
+    uint64_t num_regions() const { return _nregions; }
+    uint64_t num_funcs() const { return _nfuncs; }
+    uint64_t num_blocks() const { return _nblocks; }
+    uint64_t num_edges() const { return _nedges; }
+
+    const region_rec & region(uint64_t i) const { return _regions[i]; }
+    const func_rec & func(uint64_t i) const { return _funcs[i]; }
+    const block_rec & block(uint64_t i) const { return _blocks[i]; }
+    const edge_rec & edge(uint64_t i) const { return _edges[i]; }
+    const char * string_at(uint32_t off) const;
+
+    // discard a cache file found to be inconsistent with the binary
+    void invalidate();
+
+    /** writing **/
+
+    std::vector<region_rec> regions;
+    std::vector<func_rec> funcs;
+    std::vector<block_rec> blocks;
+    std::vector<edge_rec> edges;
+
+    uint32_t add_string(const std::string & s);
+
+    // write the records above to the cache file
+    bool write(Architecture arch);
+
+ private:
+    bool resolveCachePath();
+
+    std::string _key;
+    std::string _path;
+    std::string _strings;
+
+    MappedFile * _mf;
+    uint64_t _nregions;
+    uint64_t _nfuncs;
+    uint64_t _nblocks;
+    uint64_t _nedges;
+    uint64_t _nstrings;
+    const region_rec * _regions;
+    const func_rec * _funcs;
+    const block_rec * _blocks;
+    const edge_rec * _edges;
+    const char * _strtab;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _FLAT_RANGE_INDEX_H_
+#define _FLAT_RANGE_INDEX_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "dyntypes.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * A read-only interval index over objects with low() and high()
+ * (blocks and function extents), for CFGs that are no longer changing.
+ *
+ * Intervals are kept in flat arrays sorted by low(), alongside the
+ * running maximum of high(). The sorted lows are also stored in
+ * Eytzinger (breadth-first) order, so a search descends through
+ * consecutive cache lines instead of bisecting the whole array. A
+ * stabbing query locates the last interval starting at or before the
+ * address and walks back while the running maximum still covers it;
+ * intervals rarely overlap, so that walk is short.
+ *
+ * Intervals are half-open, as in IBSTree: [low, high).
+ *
+ * An item can be removed, which leaves an empty slot behind until the
+ * index is next built; nothing else changes once it is built.
+ */
+template <typename T>
+class FlatRangeIndex {
+ public:
+    FlatRangeIndex() { }
+
+    // replaces the contents of the index
+    void build(std::vector<T *> & items);
+    void clear();
+
+    size_t size() const { return _items.size(); }
+    bool empty() const { return _items.empty(); }
+    // items in order of low(); NULL for removed items
+    T * at(size_t i) const { return _items[i]; }
+
+    // removes item, whose low() must not have changed since the index
+    // was built; returns false if it is not in the index
+    bool remove(T * item);
+
+    // intervals containing addr
+    int find(Address addr, std::set<T *> & out) const;
+    // intervals overlapping [start, end)
+    int find(Address start, Address end, std::set<T *> & out) const;
+    // the interval with the smallest low() greater than addr
+    T * successor(Address addr) const;
+
+ private:
+    struct low_less {
+        bool operator()(const T * a, const T * b) const {
+            return a->low() < b->low();
+        }
+    };
+
+    // number of intervals with low() <= addr
+    size_t count_at_or_before(Address addr) const;
+    size_t layout(size_t next, size_t k, std::vector<Address> & lows);
+
+    std::vector<T *> _items;
+    std::vector<Address> _high;
+    std::vector<Address> _maxhigh;
+    // 1-based Eytzinger layout of the lows, and the sorted position
+    // each slot corresponds to
+    std::vector<Address> _eyt;
+    std::vector<uint32_t> _eyt_pos;
+};
+
+template <typename T>
+void FlatRangeIndex<T>::clear()
+{
+    std::vector<T *>().swap(_items);
+    std::vector<Address>().swap(_high);
+    std::vector<Address>().swap(_maxhigh);
+    std::vector<Address>().swap(_eyt);
+    std::vector<uint32_t>().swap(_eyt_pos);
+}
+
+template <typename T>
+void FlatRangeIndex<T>::build(std::vector<T *> & items)
+{
+    clear();
+    std::stable_sort(items.begin(), items.end(), low_less());
+    _items.swap(items);
+
+    size_t n = _items.size();
+    std::vector<Address> lows(n);
+    _high.resize(n);
+    _maxhigh.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        lows[i] = _items[i]->low();
+        _high[i] = _items[i]->high();
+        _maxhigh[i] = i ? std::max(_maxhigh[i-1], _high[i]) : _high[i];
+    }
+
+    _eyt.resize(n + 1);
+    _eyt_pos.resize(n + 1);
+    layout(0, 1, lows);
+}
+
+// fill the subtree rooted at slot k by in-order traversal
+template <typename T>
+size_t FlatRangeIndex<T>::layout(size_t next, size_t k, std::vector<Address> & lows)
+{
+    if (k < _eyt.size()) {
+        next = layout(next, 2*k, lows);
+        _eyt[k] = lows[next];
+        _eyt_pos[k] = (uint32_t) next;
+        ++next;
+        next = layout(next, 2*k+1, lows);
+    }
+    return next;
+}
+
+template <typename T>
+size_t FlatRangeIndex<T>::count_at_or_before(Address addr) const
+{
+    size_t n = _items.size();
+    size_t k = 1;
+    while (k <= n)
+        k = 2*k + (_eyt[k] <= addr ? 1 : 0);
+    // k's path ends with a run of right turns past the answer, then
+    // one left turn at it; strip them to recover the slot of the
+    // first low greater than addr
+    while (k & 1)
+        k >>= 1;
+    k >>= 1;
+    return k ? _eyt_pos[k] : n;
+}
+
+template <typename T>
+int FlatRangeIndex<T>::find(Address addr, std::set<T *> & out) const
+{
+    size_t sz = out.size();
+    for (size_t i = count_at_or_before(addr); i > 0 && _maxhigh[i-1] > addr; --i) {
+        if (_high[i-1] > addr && _items[i-1])
+            out.insert(_items[i-1]);
+    }
+    return out.size() - sz;
+}
+
+template <typename T>
+int FlatRangeIndex<T>::find(Address start, Address end, std::set<T *> & out) const
+{
+    size_t sz = out.size();
+    if (end <= start)
+        return 0;
+    for (size_t i = count_at_or_before(end - 1); i > 0 && _maxhigh[i-1] > start; --i) {
+        if (_high[i-1] > start && _items[i-1])
+            out.insert(_items[i-1]);
+    }
+    return out.size() - sz;
+}
+
+template <typename T>
+T * FlatRangeIndex<T>::successor(Address addr) const
+{
+    size_t i = count_at_or_before(addr);
+    while (i < _items.size() && !_items[i])
+        ++i;
+    return i < _items.size() ? _items[i] : NULL;
+}
+
+template <typename T>
+bool FlatRangeIndex<T>::remove(T * item)
+{
+    if (_items.empty())
+        return false;
+    // items with the same low() sit just before this position;
+    // removed slots among them have lost their low()
+    Address low = item->low();
+    for (size_t i = count_at_or_before(low); i > 0; --i) {
+        T * cur = _items[i-1];
+        if (cur == item) {
+            _items[i-1] = NULL;
+            return true;
+        }
+        if (cur && cur->low() < low)
+            break;
+    }
+    return false;
+}
+
+}
+}
+
+#endif
@@ -37,6 +37,7 @@
 #include "InstructionAdapter.h"
 #include "InstructionDecoder.h"
 #include "Instruction.h"
+#include "CompactInstruction.h"
 
 #include "dyntypes.h"
 
@@ -45,6 +46,10 @@
 using namespace std;
 
 namespace Dyninst {
+namespace ParseAPI {
+    class PrefetchedInsns;
+    class JumpTableBatch;
+}
 namespace InsnAdapter {
 
 class IA_IAPI : public InstructionAdapter {
@@ -70,6 +75,15 @@ class IA_IAPI : public InstructionAdapter {
           Address start, ParseAPI::CodeObject *o,
           ParseAPI::CodeRegion *r, InstructionSource *isrc, ParseAPI::Block *);
 
+        // Serve instructions from p (decoded ahead by a parsing worker)
+        // where possible; anything p lacks is decoded as usual
+        void setPrefetched(const ParseAPI::PrefetchedInsns * p) { prefetched = p; }
+
+        // Take jump table results from j (resolved ahead by parsing
+        // workers) where they are still valid
+        void setJumpTables(ParseAPI::JumpTableBatch * j) { jumpTables = j; }
+        ParseAPI::JumpTableBatch * getJumpTables() const { return jumpTables; }
+
         virtual Dyninst::InstructionAPI::Instruction::Ptr getInstruction() const;
     
         virtual bool hasCFT() const;
@@ -132,8 +146,29 @@ private:
 	void parseSysEnter(std::vector<std::pair<Address, Dyninst::ParseAPI::EdgeTypeEnum> >& outEdges) const;
         std::pair<bool, Address> getFallthrough() const;
 
+        Dyninst::InstructionAPI::Instruction::Ptr decodeCurrent();
+        Dyninst::InstructionAPI::Instruction::Ptr decodeAt(Address addr) const;
+        void decodeAll() const;
+        bool hasInsn() const;
+        entryID curID() const;
+        Dyninst::InstructionAPI::InsnCategory curCategory() const;
+        Dyninst::InstructionAPI::InstructionDecoder decoderAfterCurrent() const;
+
         Dyninst::InstructionAPI::InstructionDecoder dec;
 
+        // Instructions taken from the prefetched set bypass the decoder,
+        // leaving it behind; decSynced is false until it is re-seated
+        const ParseAPI::PrefetchedInsns * prefetched;
+        bool decSynced;
+
+        // On x86 the parser only pre-decodes through the opcode tables;
+        // the entry in allInsns stays NULL until something asks for the
+        // full Instruction. curCompact is invalid when the current entry
+        // was decoded in full.
+        Dyninst::InstructionAPI::CompactInstruction curCompact;
+
+        ParseAPI::JumpTableBatch * jumpTables;
+
         /*
          * Decoded instruction cache: contains the linear
          * sequence of instructions decoded by the decoder
@@ -141,6 +176,8 @@ private:
          * 
          * - curInsnIter == *(allInsns.end()-1)
          * - (super)->current = curInsnIter->first
+         * - a NULL Instruction may be a pre-decoded one; decodeAll()
+         *   fills these in before the sequence is walked
          */
 public:
         typedef std::vector< 
@@ -148,7 +185,7 @@ public:
             Dyninst::InstructionAPI::Instruction::Ptr> 
         > allInsns_t;
 private:
-        allInsns_t allInsns;
+        mutable allInsns_t allInsns;
         Dyninst::InstructionAPI::Instruction::Ptr curInsn() const;
         allInsns_t::iterator curInsnIter;
 
@@ -14,6 +14,7 @@ class IndirectControlFlowAnalyzer {
     ParseAPI::Block *block;
     set<ParseAPI::Block*> reachable;
     ThunkData thunks;
+    SliceContext *context;
 
     void GetAllReachableBlock();  
     void FindAllThunks();
@@ -26,7 +27,10 @@ class IndirectControlFlowAnalyzer {
 
 public:
     bool NewJumpTableAnalysis(std::vector<std::pair< Address, Dyninst::ParseAPI::EdgeTypeEnum > >& outEdges);
-    IndirectControlFlowAnalyzer(ParseAPI::Function *f, ParseAPI::Block *b): func(f), block(b) {}
+    // the slice's instructions and assignments come from context, if
+    // given, which may be shared by concurrent analyses
+    IndirectControlFlowAnalyzer(ParseAPI::Function *f, ParseAPI::Block *b,
+                                SliceContext *c = NULL): func(f), block(b), context(c) {}
 
 };
 
@@ -0,0 +1,127 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _INSN_PREFETCHER_H_
+#define _INSN_PREFETCHER_H_
+
+#include <map>
+#include <vector>
+#include <utility>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "dyntypes.h"
+#include "Instruction.h"
+#include "common/src/WorkStealingPool.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class Function;
+class ParseData;
+
+/*
+ * The instructions of one function, decoded ahead of time by a
+ * parsing worker. Sorted by address.
+ */
+class PrefetchedInsns {
+ public:
+    typedef std::vector<std::pair<Address,
+        InstructionAPI::Instruction::Ptr> > insn_vec;
+
+    InstructionAPI::Instruction::Ptr find(Address addr) const;
+    size_t size() const { return insns.size(); }
+
+    insn_vec insns;
+};
+
+/*
+ * Multi-threaded parsing support.
+ *
+ * CFG construction itself stays on the parsing thread so that block
+ * splitting, delayed frames and tail-call resolution happen in exactly
+ * the order of a serial parse. What runs on the workers is the part of
+ * parsing that does not depend on that order: decoding each function's
+ * instruction stream. A worker follows the direct intraprocedural
+ * control flow from a function's entry, and spawns a task for every
+ * known function it finds a direct call to, so that callees are
+ * decoded (on the same worker, unless stolen) before the parser
+ * suspends the caller to parse them.
+ *
+ * The parser claims a function's instructions when it starts its
+ * frame. Claiming never blocks: a function still being decoded is
+ * simply decoded again by the parser, so the result never depends on
+ * worker timing.
+ */
+class InsnPrefetcher {
+ public:
+    InsnPrefetcher(ParseData * pd, unsigned num_threads);
+    ~InsnPrefetcher();
+
+    // queue f for decoding if it has not been parsed or queued
+    void prefetch(Function * f);
+
+    // take ownership of f's decoded instructions, if ready
+    boost::shared_ptr<PrefetchedInsns> claim(Function * f);
+
+ private:
+    enum state_t {
+        QUEUED,
+        RUNNING,
+        READY,
+        ABANDONED
+    };
+    struct entry_t {
+        state_t state;
+        boost::shared_ptr<PrefetchedInsns> insns;
+        entry_t() : state(QUEUED) { }
+    };
+
+    class DecodeTask;
+    friend class DecodeTask;
+
+    bool start(Function * f);
+    void finish(Function * f, boost::shared_ptr<PrefetchedInsns> insns);
+    void decode(Function * f, PrefetchedInsns & out);
+
+    ParseData * _pd;
+
+    boost::mutex _lock;
+    std::map<Function *, entry_t> _entries;
+    unsigned long _cached;  // instructions held in READY entries
+
+    // declared last; the pool is joined before the fields above go away
+    WorkStealingPool _pool;
+};
+
+}
+}
+
+#endif
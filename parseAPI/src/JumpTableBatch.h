@@ -0,0 +1,107 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _JUMP_TABLE_BATCH_H_
+#define _JUMP_TABLE_BATCH_H_
+
+#include <map>
+#include <vector>
+#include <utility>
+
+#include <stdint.h>
+
+#include "dyntypes.h"
+#include "CFG.h"
+
+namespace Dyninst {
+
+class SliceContext;
+
+namespace ParseAPI {
+
+/*
+ * Jump tables of one function, resolved ahead of the parse.
+ *
+ * Indirect jumps are resolved last in a frame, once everything else
+ * in the function has been parsed. At that point the parser hands
+ * every pending indirect jump to resolve(), which runs the slicing
+ * analyses for all of them on a pool of workers; the CFG is not
+ * modified while they run.
+ *
+ * The parser still adds the resulting edges one jump at a time, in
+ * worklist order. Each result is recorded along with a signature of
+ * the part of the CFG the analysis looked at (the blocks that reach
+ * the indirect jump and their edges). If resolving an earlier jump
+ * table changed that part of the CFG, the result is discarded and the
+ * jump is analyzed again, so the CFG is the same as a serial parse.
+ *
+ * The analyses of one resolve() share the decoded instructions and
+ * assignments of the blocks they slice through (see SliceContext).
+ */
+class JumpTableBatch {
+ public:
+    typedef std::vector<std::pair<Address, EdgeTypeEnum> > edge_vec;
+
+    JumpTableBatch();
+    ~JumpTableBatch();
+
+    // analyze the indirect jumps ending blocks (of f) that have
+    // no result yet
+    void resolve(Function * f, std::vector<Block *> const& blocks,
+        unsigned num_threads);
+
+    bool has(Block * b) const { return _results.count(b) != 0; }
+
+    // hand out (and forget) the result for b, if it is still valid
+    bool claim(Function * f, Block * b, bool & ret, edge_vec & outEdges);
+
+ private:
+    struct result_t {
+        uint64_t sig;
+        bool ret;
+        edge_vec edges;
+        result_t() : sig(0), ret(false) { }
+    };
+
+    class ResolveTask;
+
+    static uint64_t signature(Function * f, Block * b);
+
+    std::map<Block *, result_t> _results;
+    SliceContext * _context;
+
+    JumpTableBatch(const JumpTableBatch &);
+    JumpTableBatch & operator=(const JumpTableBatch &);
+};
+
+}
+}
+
+#endif
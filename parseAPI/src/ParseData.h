@@ -37,10 +37,12 @@
 #include "dyntypes.h"
 #include "IBSTree.h"
 #include "IBSTree-fast.h"
+#include "FlatRangeIndex.h"
 #include "CodeObject.h"
 #include "CFG.h"
 #include "ParserDetails.h"
 #include "debug_parse.h"
+#include "common/src/dthread.h"
 
 
 using namespace std;
@@ -50,6 +52,8 @@ namespace ParseAPI {
 
 class Parser;
 class ParseData;
+class PrefetchedInsns;
+class JumpTableBatch;
 
 /** Describes a saved frame during recursive parsing **/
 // Parsing data for a function. 
@@ -124,6 +128,12 @@ class ParseFrame {
 
     ParseWorkElem * seed; // stored for cleanup
 
+    // instructions decoded ahead of the parse, if any
+    boost::shared_ptr<PrefetchedInsns> prefetched;
+
+    // indirect jumps resolved ahead of the parse, if any
+    JumpTableBatch * jump_tables;
+
     ParseFrame(Function * f,ParseData *pd) :
         curAddr(0),
         num_insns(0),
@@ -131,6 +141,7 @@ class ParseFrame {
         func(f),
         codereg(f->region()),
         seed(NULL),
+        jump_tables(NULL),
         _pd(pd)
     {
         set_status(UNPARSED);
@@ -145,9 +156,28 @@ class ParseFrame {
     ParseData * _pd;
 };
 
-/* per-CodeRegion parsing data */
+/* per-CodeRegion parsing data
+ *
+ * The lookup structures may be read by parallel parsing workers
+ * while the parser inserts into them; `lock' guards every access
+ * made through the methods below. Callers changing the structures
+ * directly must hold it and use the *_nolock mutators.
+ *
+ * When the parser uses flat lookups, finalizing the CFG freezes the
+ * lookup structures: their contents move into flat arrays sorted by
+ * address, and the hash maps and interval trees are released. This
+ * is far smaller, and lookups become binary searches over contiguous
+ * memory. Later changes do not undo this: the (now empty) dynamic
+ * structures collect them as an overlay that lookups consult first,
+ * with removals recorded as tombstones. The next freeze() folds the
+ * overlay back into the arrays once it has grown large.
+ */
 class region_data { 
  public:
+    Mutex<> lock;
+
+    region_data() : _frozen(false), _overlay(0) { }
+
   // Function lookups
   Dyninst::IBSTree_fast<FuncExtent> funcsByRange;
     dyn_hash_map<Address, Function *> funcsByAddr;
@@ -165,6 +195,21 @@ class region_data {
     int findFuncs(Address addr, set<Function *> & funcs);
     int findBlocks(Address addr, set<Block *> & blocks);
 
+    void record_func(Function * f);
+    void record_block(Block * b);
+    void record_extent(FuncExtent * e);
+    ParseFrame::Status frameStatus(Address entry);
+    void setFrameStatus(Address entry, ParseFrame::Status status);
+
+    // mutators for callers already holding `lock'
+    void set_func_nolock(Address entry, Function * f);
+    void erase_func_nolock(Address entry);
+    void erase_block_nolock(Address entry);
+    void erase_status_nolock(Address entry);
+    void insert_block_range_nolock(Block * b);
+    void remove_block_range_nolock(Block * b);
+    void remove_extent_nolock(FuncExtent * e);
+
     /* 
      * Look up the next block for detection of straight-line
      * fallthrough edges into existing blocks.
@@ -173,8 +218,15 @@ class region_data {
     {
         Block * nextBlock = NULL;
         Address nextBlockAddr = numeric_limits<Address>::max();
+        ScopeLock<> l(lock);
 
-        if((nextBlock = blocksByRange.successor(addr)) &&
+        nextBlock = blocksByRange.successor(addr);
+        if(_frozen) {
+            Block * flat = _flat_block_ranges.successor(addr);
+            if(flat && (!nextBlock || flat->start() < nextBlock->start()))
+                nextBlock = flat;
+        }
+        if(nextBlock &&
            nextBlock->start() > addr)
         {
             nextBlockAddr = nextBlock->start();   
@@ -185,27 +237,74 @@ class region_data {
     
 	 // Find functions within [start,end)
 	 int findFuncs(Address start, Address end, set<Function *> & funcs);
+
+    // move the lookup structures into (or fold the overlay back into)
+    // the flat arrays
+    void freeze();
+    bool frozen() const { return _frozen; }
+
+ private:
+    template <typename T>
+    struct flat_less {
+        bool operator()(const pair<Address, T> & a, const pair<Address, T> & b) const
+        { return a.first < b.first; }
+    };
+    template <typename T>
+    static T * flat_find(const vector<pair<Address, T> > & v, Address a);
+
+    // merge the arrays and the overlay back into the dynamic structures
+    void thaw();
+
+    bool _frozen;
+    // changes made since the last freeze
+    unsigned long _overlay;
+    vector<pair<Address, Function *> > _flat_funcs;
+    vector<pair<Address, Block *> > _flat_blocks;
+    vector<pair<Address, ParseFrame::Status> > _flat_status;
+    FlatRangeIndex<FuncExtent> _flat_func_ranges;
+    FlatRangeIndex<Block> _flat_block_ranges;
 };
 
 /** region_data inlines **/
 
+template <typename T>
+inline T *
+region_data::flat_find(const vector<pair<Address, T> > & v, Address a)
+{
+    typename vector<pair<Address, T> >::const_iterator it =
+        lower_bound(v.begin(), v.end(), make_pair(a, T()), flat_less<T>());
+    if(it != v.end() && it->first == a)
+        return const_cast<T *>(&it->second);
+    return NULL;
+}
+
+// While frozen, an overlay entry overrides the arrays; a NULL function
+// or block, or a BAD_LOOKUP status, marks an entry removed since
 inline Function *
 region_data::findFunc(Address entry)
 {
+    ScopeLock<> l(lock);
     dyn_hash_map<Address, Function *>::iterator fit;
     if((fit = funcsByAddr.find(entry)) != funcsByAddr.end())
         return fit->second;
-    else
-        return NULL;
+    if(_frozen) {
+        Function ** f = flat_find(_flat_funcs,entry);
+        return f ? *f : NULL;
+    }
+    return NULL;
 }
 inline Block *
 region_data::findBlock(Address entry)
 {
+    ScopeLock<> l(lock);
     dyn_hash_map<Address, Block *>::iterator bit;
     if((bit = blocksByAddr.find(entry)) != blocksByAddr.end())
         return bit->second;
-    else
-        return NULL;
+    if(_frozen) {
+        Block ** b = flat_find(_flat_blocks,entry);
+        return b ? *b : NULL;
+    }
+    return NULL;
 }
 inline int
 region_data::findFuncs(Address addr, set<Function *> & funcs)
@@ -215,7 +314,12 @@ region_data::findFuncs(Address addr, set<Function *> & funcs)
     set<FuncExtent *> extents;
     set<FuncExtent *>::iterator eit;
     
-    funcsByRange.find(addr,extents);
+    {
+        ScopeLock<> l(lock);
+        if(_frozen)
+            _flat_func_ranges.find(addr,extents);
+        funcsByRange.find(addr,extents);
+    }
     for(eit = extents.begin(); eit != extents.end(); ++eit)
         funcs.insert((*eit)->func());
  
@@ -230,7 +334,12 @@ region_data::findFuncs(Address start, Address end, set<Function *> & funcs)
     set<FuncExtent *> extents;
     set<FuncExtent *>::iterator eit;
     
-    funcsByRange.find(&dummy,extents);
+    {
+        ScopeLock<> l(lock);
+        if(_frozen)
+            _flat_func_ranges.find(start,end,extents);
+        funcsByRange.find(&dummy,extents);
+    }
     for(eit = extents.begin(); eit != extents.end(); ++eit)
         funcs.insert((*eit)->func());
  
@@ -241,9 +350,110 @@ region_data::findBlocks(Address addr, set<Block *> & blocks)
 {
     int sz = blocks.size();
 
+    ScopeLock<> l(lock);
+    if(_frozen)
+        _flat_block_ranges.find(addr,blocks);
     blocksByRange.find(addr,blocks);
     return blocks.size() - sz;
 }
+inline void
+region_data::set_func_nolock(Address entry, Function * f)
+{
+    if(_frozen) ++_overlay;
+    funcsByAddr[entry] = f;
+}
+inline void
+region_data::erase_func_nolock(Address entry)
+{
+    if(_frozen) {
+        ++_overlay;
+        funcsByAddr[entry] = NULL;
+    } else
+        funcsByAddr.erase(entry);
+}
+inline void
+region_data::erase_block_nolock(Address entry)
+{
+    if(_frozen) {
+        ++_overlay;
+        blocksByAddr[entry] = NULL;
+    } else
+        blocksByAddr.erase(entry);
+}
+inline void
+region_data::erase_status_nolock(Address entry)
+{
+    if(_frozen) {
+        ++_overlay;
+        frame_status[entry] = ParseFrame::BAD_LOOKUP;
+    } else
+        frame_status.erase(entry);
+}
+inline void
+region_data::insert_block_range_nolock(Block * b)
+{
+    if(_frozen) ++_overlay;
+    blocksByRange.insert(b);
+}
+inline void
+region_data::remove_block_range_nolock(Block * b)
+{
+    if(_frozen) {
+        ++_overlay;
+        _flat_block_ranges.remove(b);
+    }
+    blocksByRange.remove(b);
+}
+inline void
+region_data::remove_extent_nolock(FuncExtent * e)
+{
+    if(_frozen) {
+        ++_overlay;
+        _flat_func_ranges.remove(e);
+    }
+    funcsByRange.remove(e);
+}
+inline void
+region_data::record_func(Function * f)
+{
+    ScopeLock<> l(lock);
+    set_func_nolock(f->addr(),f);
+}
+inline void
+region_data::record_block(Block * b)
+{
+    ScopeLock<> l(lock);
+    if(_frozen) ++_overlay;
+    blocksByAddr[b->start()] = b;
+    insert_block_range_nolock(b);
+}
+inline void
+region_data::record_extent(FuncExtent * e)
+{
+    ScopeLock<> l(lock);
+    if(_frozen) ++_overlay;
+    funcsByRange.insert(e);
+}
+inline ParseFrame::Status
+region_data::frameStatus(Address entry)
+{
+    ScopeLock<> l(lock);
+    dyn_hash_map<Address, ParseFrame::Status>::iterator sit;
+    if((sit = frame_status.find(entry)) != frame_status.end())
+        return sit->second;
+    if(_frozen) {
+        ParseFrame::Status * st = flat_find(_flat_status,entry);
+        return st ? *st : ParseFrame::BAD_LOOKUP;
+    }
+    return ParseFrame::BAD_LOOKUP;
+}
+inline void
+region_data::setFrameStatus(Address entry, ParseFrame::Status status)
+{
+    ScopeLock<> l(lock);
+    if(_frozen) ++_overlay;
+    frame_status[entry] = status;
+}
 
 
 /** end region_data **/
@@ -285,6 +495,9 @@ class ParseData {
     // does the Right Thing(TM) for standard- and overlapping-region 
     // object types
     virtual CodeRegion * reglookup(CodeRegion *cr, Address addr) =0;
+
+    // compact the lookup structures of a finalized CFG
+    virtual void freeze() =0;
 };
 
 /* StandardParseData represents parse data for Parsers that disallow
@@ -320,6 +533,8 @@ class StandardParseData : public ParseData {
     void remove_extents(const std::vector<FuncExtent*> &extents);
 
     CodeRegion * reglookup(CodeRegion *cr, Address addr);
+
+    void freeze() { _rdata.freeze(); }
 };
 
 inline region_data * StandardParseData::findRegion(CodeRegion * /* cr */)
@@ -328,12 +543,11 @@ inline region_data * StandardParseData::findRegion(CodeRegion * /* cr */)
 }
 inline void StandardParseData::record_func(Function *f)
 {
-    _rdata.funcsByAddr[f->addr()] = f;
+    _rdata.record_func(f);
 }
 inline void StandardParseData::record_block(CodeRegion * /* cr */, Block *b)
 {
-    _rdata.blocksByAddr[b->start()] = b;
-    _rdata.blocksByRange.insert(b);
+    _rdata.record_block(b);
 }
 
 /* OverlappingParseData handles binary code objects like .o files
@@ -370,6 +584,8 @@ class OverlappingParseData : public ParseData {
     void remove_extents(const std::vector<FuncExtent*> &extents);
 
     CodeRegion * reglookup(CodeRegion *cr, Address addr);
+
+    void freeze();
 };
 
 }
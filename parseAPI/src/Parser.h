@@ -30,6 +30,7 @@
 #ifndef _PARSER_H_
 #define _PARSER_H_
 
+#include <map>
 #include <set>
 #include <vector>
 #include <queue>
@@ -56,6 +57,8 @@ namespace Dyninst {
 namespace ParseAPI {
 
    class CFGModifier;
+   class InsnPrefetcher;
+   class CFGCache;
 
 /** This is the internal parser **/
 class Parser {
@@ -109,6 +112,30 @@ class Parser {
     bool _in_parse;
     bool _in_finalize;
 
+    // threads used by parse(); 1 parses serially
+    unsigned _num_threads;
+    // decodes functions ahead of the parser while parse() runs
+    InsnPrefetcher * _prefetcher;
+
+    // load and store parse() results in the persistent CFG cache
+    bool _use_cache;
+    // freeze the lookup structures when the CFG is finalized
+    bool _flat_lookups;
+    // the validated cache is restored one group of related regions
+    // at a time, as lookups reach them (Parser-cache.C)
+    bool _cache_tried;
+    bool _cached;
+    CFGCache * _cache;
+    vector<unsigned> _cache_group;  // region index -> group
+    vector<bool> _cache_loaded;     // group -> restored
+    unsigned _cache_pending;
+
+    // parse only what lookups need rather than everything at once;
+    // functions are indexed by entry so that the function owning an
+    // address can be found before it has been parsed
+    bool _lazy;
+    std::map<std::pair<CodeRegion *, Address>, Function *> _lazy_entries;
+
  public:
     Parser(CodeObject & obj, CFGFactory & fact, ParseCallbackManager & pcb);
     ~Parser();
@@ -118,6 +145,7 @@ class Parser {
 
     // functions
     Function * findFuncByEntry(CodeRegion * cr, Address entry);
+    Function * findCurrentFuncByEntry(CodeRegion * cr, Address entry);
     int findFuncs(CodeRegion * cr, Address addr, set<Function*> & funcs);
     int findFuncs(CodeRegion * cr, Address start, Address end, set<Function*> & funcs);
 
@@ -129,6 +157,12 @@ class Parser {
     Block * findNextBlock(CodeRegion * cr, Address addr);
 
     void parse();
+    void set_num_threads(unsigned num_threads) { _num_threads = num_threads; }
+    void set_use_cache(bool use_cache) { _use_cache = use_cache; }
+    void set_flat_lookups(bool flat) { _flat_lookups = flat; }
+    // restore cached CFG for a region (NULL: all regions)
+    void load_cache(CodeRegion * cr = NULL);
+    void set_lazy(bool lazy);
     void parse_at(CodeRegion *cr, Address addr, bool recursive, FuncSource src);
     void parse_at(Address addr, bool recursive, FuncSource src);
     void parse_edges(vector< ParseWorkElem * > & work_elems);
@@ -149,6 +183,7 @@ class Parser {
     void init_frame(ParseFrame & frame);
 
     void finalize(Function *f);
+    void finalize(Block *b);
 
  private:
     void parse_vanilla();
@@ -156,8 +191,19 @@ class Parser {
     void probabilistic_gap_parsing(CodeRegion* cr);
     //void parse_sbp();
 
+    // persistent CFG cache (Parser-cache.C)
+    bool cacheable();
+    bool open_cache();
+    void load_cache_group(unsigned group);
+    void save_cache();
+
     ParseFrame::Status frame_status(CodeRegion * cr, Address addr);
 
+    // lazy mode: parse the function(s) a lookup may return
+    void parse_lazy(Function * f);
+    void parse_lazy(CodeRegion * cr, Address addr);
+    void parse_lazy(CodeRegion * cr, Address start, Address end);
+
     /** CFG structure manipulations **/
     void end_block(Block *b, InstructionAdapter_t & ah);
     Block * block_at(Function * owner, 
@@ -214,6 +260,10 @@ class Parser {
         Block*,
         InstructionAdapter_t&);
 
+    /* deferred indirect jumps */
+    Block * jump_table_block(ParseFrame &, ParseWorkElem *);
+    void resolve_jump_tables(ParseFrame &, Block *);
+
     void finalize();
     void finalize_funcs(vector<Function *> & funcs);
 
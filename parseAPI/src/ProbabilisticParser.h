@@ -41,6 +41,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <queue>
 
 #include <ctime>
 
@@ -60,6 +61,8 @@ using Dyninst::ParseAPI::Parser;
 using Dyninst::ParseAPI::Function;
 using Dyninst::InstructionAPI::Instruction;
 
+namespace Dyninst { class WorkStealingPool; }
+
 namespace hd {
 #define WILDCARD_ENTRY_ID 0xaaaa
 
@@ -147,6 +150,14 @@ public:
     IdiomPrefixTree * getPrefixIdiomTreeRoot() { return &prefix; }
 };
 
+struct ProbAndAddr {
+    Address addr;
+    double prob;
+
+    ProbAndAddr(Address a, double p): addr(a), prob(p) {}
+    bool operator < (const ProbAndAddr &p) const;
+};
+
 class ProbabilityCalculator {
 
     struct DecodeData {
@@ -159,6 +170,32 @@ class ProbabilityCalculator {
         DecodeData() : entry_id(0), arg1(0), arg2(0), len(0) {}	    
     };
 
+    // save the idiom extraction results for idiom matching at different addresses.
+    // Addresses inside the window are kept in a dense array indexed by offset;
+    // idiom matching looks a few instructions past either end of the window,
+    // and those addresses go to a hash map.
+    class DecodeCache {
+        Address base;
+	std::vector<DecodeData> dense;
+	dyn_hash_map<Address, DecodeData> sparse;
+    public:
+        DecodeCache() : base(0) {}
+	void setWindow(Address start, Address end);
+	// NULL if addr has not been decoded yet
+	const DecodeData *find(Address addr) const;
+	void insert(Address addr, const DecodeData &data);
+    };
+
+    // FEP probabilities from idiom matching, computed ahead of the
+    // scan for a window of a gap and indexed by offset from its start
+    struct GapProbs {
+        Address start;
+	std::vector<double> prob;
+	GapProbs(Address s, Address e) : start(s), prob(e - s, 0) {}
+	bool contains(Address addr) const { return addr >= start && addr - start < prob.size(); }
+    };
+    class ScanTask;
+
     IdiomModel model;
     CodeRegion* cr;
     CodeSource* cs;
@@ -167,17 +204,22 @@ class ProbabilityCalculator {
     dyn_hash_map<Address, double> FEPProb;
     // The highest probability reaching to this address in enforcing overlapping constraints
     dyn_hash_map<Address, double> reachingProb;
+    // Precomputed by scanAhead, sorted by start address.
+    // FEPProb and reachingProb take precedence over these.
+    std::vector<GapProbs*> gapProbs;
+    unsigned num_threads;
+    Dyninst::WorkStealingPool *pool;
     
     dyn_hash_set<Function *> finalized;
 
-    // save the idiom extraction results for idiom matching at different addresses 
-    typedef dyn_hash_map<Address, DecodeData > DecodeCache;
     DecodeCache decodeCache;
 
+    // Match idioms at addr and return the resulting probability
+    double matchIdioms(Address addr, DecodeCache &cache);
     // Recursively mathcing normal idioms and calculate weights
-    double calcForwardWeights(int cur, Address addr, IdiomPrefixTree *tree, bool &valid);
+    double calcForwardWeights(int cur, Address addr, IdiomPrefixTree *tree, bool &valid, DecodeCache &cache);
     // Recursively mathcing prefix idioms and calculate weights
-    double calcBackwardWeights(int cur, Address addr, IdiomPrefixTree *tree, std::set<IdiomPrefixTree*> &matched);
+    double calcBackwardWeights(int cur, Address addr, IdiomPrefixTree *tree, std::set<IdiomPrefixTree*> &matched, DecodeCache &cache);
     // Enforce the overlapping constraints and
     // return true if the cur_addr doesn't conflict with other identified functions,
     // otherwise return false
@@ -187,23 +229,36 @@ class ProbabilityCalculator {
 				       dyn_hash_map<Address, double> &newFEPProb,
 				       dyn_hash_map<Address, double> &newReachingProb,
 				       dyn_hash_set<Function*> &newDiscoveredFuncs);
-    bool decodeInstruction(DecodeData &data, Address addr);
+    bool decodeInstruction(DecodeData &data, Address addr, DecodeCache &cache);
+
+    // Idiom matching for [start, end), which lies within one gap
+    void scanRange(GapProbs *gp, Address start, Address end);
+    const GapProbs *findGapProbs(Address addr) const;
 
     void Finalize(dyn_hash_map<Address, double> &newFEPProb,
                   dyn_hash_map<Address, double> &newReachingProb,
 		  dyn_hash_set<Function*> &newDiscoveredFuncs);
     void Remove(dyn_hash_set<Function*> &newDiscoveredFuncs);
     double getReachingProb(Address addr);
+    // Whether addr has been given a probability, by matching idioms
+    // or by enforcing constraints
+    bool hasProb(Address addr);
+    // Every address whose probability reaches the threshold, highest first
+    void getFEPCandidates(std::priority_queue<ProbAndAddr> &q);
    
 
 public:
     ProbabilityCalculator(CodeRegion *reg, CodeSource *source, Parser *parser, std::string model_spec);
-	virtual ~ProbabilityCalculator() {
-		FEPProb.clear();
-	    reachingProb.clear();
-		finalized.clear();
-	}
+    virtual ~ProbabilityCalculator();
     double calcProbByMatchingIdioms(Address addr);
+    // Threads used by scanAhead (0 for one per hardware thread);
+    // with 1, every address is matched when it is queried
+    void setNumThreads(unsigned n) { num_threads = n; }
+    // Called before querying addr, in a gap ending at gapEnd: match
+    // idioms for a window of the gap starting at addr at once, split
+    // among the threads. Gives the same probabilities as
+    // calcProbByMatchingIdioms.
+    void scanAhead(Address addr, Address gapEnd);
     void calcProbByEnforcingConstraints();
     double getFEPProb(Address addr);
     bool isFEP(Address addr);
@@ -266,6 +266,7 @@ class PATCHAPI_EXPORT PatchFunction {
      void destroyPoints();
      void destroyBlockPoints(PatchBlock *block);
      void invalidateBlocks();
+     void invalidateAnalyses();
 
      ParseAPI::Function *func_;
      PatchObject* obj_;
@@ -33,6 +33,7 @@
 #include "common/src/headers.h"
 
 #include <map>
+#include <boost/thread/mutex.hpp>
 
 namespace Dyninst {
 
@@ -67,6 +68,43 @@ class SYMLITE_EXPORT SymElf : public Dyninst::SymReader
    
    void createSymCache();
    Symbol_t lookupCachedSymbol(Dyninst::Offset offset);
+
+   // Name lookup state, built on the first getSymbolByName under
+   // name_lookup_lock.  Symbol tables with a .gnu.hash or .hash section
+   // are searched through it; the symbols a hash section leaves out
+   // (all of an unhashed table, those below a .gnu.hash symoffset) share
+   // name_index, an open-addressing table holding the first defined
+   // symbol of each name.
+   struct NameSection {
+      Elf_X_Shdr shdr;
+      Elf_X_Sym syms;
+      const char *strs;
+      unsigned long strs_size;
+      unsigned long hash_type;  // SHT_GNU_HASH, SHT_HASH or 0
+      const unsigned char *hash;
+      unsigned long hash_words; // in hash_entsize units
+      unsigned hash_entsize;
+      unsigned long hash_first; // symbols below this are in name_index
+   };
+   struct NameIndexEntry {
+      unsigned hash;
+      unsigned sec;
+      unsigned idx;
+   };
+   NameSection *name_sections;
+   unsigned name_sections_size;
+   bool name_lookup_init;
+   NameIndexEntry *name_index;
+   unsigned name_index_mask;
+   bool name_index_init;
+   boost::mutex name_lookup_lock;
+
+   void initNameLookup();
+   void attachHashSection(NameSection &ns, Elf_X_Shdr &hash_shdr);
+   void buildNameIndex();
+   bool symbolNamed(const NameSection &ns, unsigned long idx, const char *name);
+   bool hashLookup(const NameSection &ns, const char *name, unsigned &idx);
+   const NameIndexEntry *indexLookup(const char *name);
    
    void init();
    unsigned long getSymOffset(const Elf_X_Sym &symbol, unsigned idx);   
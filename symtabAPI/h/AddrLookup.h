@@ -41,6 +41,8 @@ class LoadedLib;
 
 namespace SymtabAPI {
 
+struct AddressInfo;
+
 typedef struct {
    std::string name;
    Address codeAddr;
@@ -62,6 +64,7 @@ class SYMTAB_EXPORT AddressLookup : public AnnotatableSparse
    LoadedLib *getLoadedLib(Symtab *sym);
    Dyninst::Address symToAddress(LoadedLib *ll, Symbol *sym);
    Symtab *getSymtab(LoadedLib *);
+   void openSymtabs(const std::vector<LoadedLib *> &libs);
  public:
    static AddressLookup *createAddressLookup(ProcessReader *reader = NULL);
    static AddressLookup *createAddressLookup(PID pid, ProcessReader *reader = NULL);
@@ -81,6 +84,12 @@ class SYMTAB_EXPORT AddressLookup : public AnnotatableSparse
    bool getExecutable(LoadedLibrary &lib);
    bool getOffset(Address addr, LoadedLibrary &lib, Offset &off);
 
+   // Symbolizes a batch of process addresses, which may span any number
+   // of loaded objects: info[i] describes addrs[i] (see
+   // Symtab::getAddressInfo), with a NULL symtab if no object holds it.
+   bool getAddressInfo(const std::vector<Address> &addrs,
+                       std::vector<AddressInfo> &info);
+
    bool refresh();
 
    Address getLibraryTrapAddrSysV();
@@ -198,9 +198,9 @@ class SYMTAB_EXPORT InlinedFunction : public FunctionBase
    virtual Offset getOffset() const;
    virtual unsigned getSize() const;
   private:
-   const char* callsite_file;
+   InternedString callsite_file;
    Dyninst::Offset callsite_line;
-   std::string name_;
+   InternedString name_;
    Module* module_;
    Dyninst::Offset offset_;
 };
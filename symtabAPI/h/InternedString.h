@@ -0,0 +1,111 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(_InternedString_h_)
+#define _InternedString_h_
+
+#include <string>
+#include <cstddef>
+#include <atomic>
+
+#include "util.h"
+
+namespace Dyninst{
+namespace SymtabAPI{
+
+/*
+ * A handle to a string kept in a process-wide pool.
+ *
+ * Each distinct string is stored once, for as long as any handle to
+ * it exists, and two handles are equal exactly when their strings
+ * are. Handles count references; the last one to go frees the string.
+ * Comparing or hashing handles only looks at the pointer. The pool is
+ * safe to use from several threads at once.
+ */
+class SYMTAB_EXPORT InternedString {
+ public:
+   // the empty string
+   InternedString();
+   explicit InternedString(const std::string &s);
+   explicit InternedString(const char *s);
+
+   InternedString(const InternedString &o) : e_(o.e_) { acquire(); }
+   InternedString &operator=(const InternedString &o)
+   {
+      if (e_ != o.e_) {
+         o.acquire();
+         release(e_);
+         e_ = o.e_;
+      }
+      return *this;
+   }
+   ~InternedString() { release(e_); }
+
+   const std::string &str() const { return e_->str; }
+   const char *c_str() const { return e_->str.c_str(); }
+   bool empty() const { return e_->str.empty(); }
+   std::size_t size() const { return e_->str.size(); }
+
+   bool operator==(const InternedString &o) const { return e_ == o.e_; }
+   bool operator!=(const InternedString &o) const { return e_ != o.e_; }
+   // an arbitrary but stable order, for ordered containers
+   bool operator<(const InternedString &o) const { return e_ < o.e_; }
+
+   std::size_t hash() const { return reinterpret_cast<std::size_t>(e_) >> 3; }
+
+   // Finds the handle for s without adding s to the pool; a string
+   // that no handle refers to can't be the name of anything
+   static bool find(const std::string &s, InternedString &ret);
+
+   struct entry_t {
+      entry_t(const std::string &s, std::size_t h) : str(s), hash(h), refs(0) { }
+      const std::string str;
+      const std::size_t hash;
+      mutable std::atomic<unsigned long> refs;
+   };
+
+ private:
+   explicit InternedString(const entry_t *e) : e_(e) { }
+
+   void acquire() const { e_->refs.fetch_add(1, std::memory_order_relaxed); }
+   static void release(const entry_t *e);
+
+   const entry_t *e_;
+};
+
+inline std::size_t hash_value(const InternedString &s)
+{
+   return s.hash();
+}
+
+}//namespace SymtabAPI
+}//namespace Dyninst
+
+#endif
@@ -46,6 +46,9 @@ class SYMTAB_EXPORT LineInformation :
                         private RangeLookup< Statement, Statement::StatementLess > 
 {
 	bool addItem_impl(Statement);
+	// told about lines added other than while parsing debug information
+	Symtab *owner_;
+	friend class Module;
    public:
       typedef RangeLookup< Statement, Statement::StatementLess >::const_iterator const_iterator;
       typedef RangeLookup< Statement, Statement::StatementLess >::AddressRange AddressRange;
@@ -58,6 +61,12 @@ class SYMTAB_EXPORT LineInformation :
             unsigned int lineOffset, 
             Offset lowInclusiveAddr, 
             Offset highExclusiveAddr );
+      /* The same, for a file name that is already pooled. */
+      bool addLine( InternedString lineSource, 
+            unsigned int lineNo, 
+            unsigned int lineOffset, 
+            Offset lowInclusiveAddr, 
+            Offset highExclusiveAddr );
 
       void addLineInfo(LineInformation *lineInfo);	      
 
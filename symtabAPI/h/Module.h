@@ -33,6 +33,7 @@
  
 #include "symutil.h"
 #include "Symbol.h"
+#include "InternedString.h"
 
 #include "Annotatable.h"
 #include "Serialization.h"
@@ -50,10 +51,22 @@ class SYMTAB_EXPORT Statement : public AnnotatableSparse, public Serializable
 	friend class Module;
 	friend class std::vector<Statement>;
 	friend class LineInformation;
+	friend class LineTable;
 
 	Statement(const char *file, unsigned int line, unsigned int col = 0,
              Offset start_addr = (Offset) -1L, Offset end_addr = (Offset) -1L) :
-      file_(file ? std::string(file) : std::string()),
+      file_(file ? InternedString(file) : InternedString()),
+      line_(line),
+      start_addr_(start_addr),
+      end_addr_(end_addr),
+      first(file_.c_str()),
+      second(line_),
+      column(col)
+      {
+      }
+	Statement(InternedString file, unsigned int line, unsigned int col = 0,
+             Offset start_addr = (Offset) -1L, Offset end_addr = (Offset) -1L) :
+      file_(file),
       line_(line),
       start_addr_(start_addr),
       end_addr_(end_addr),
@@ -63,7 +76,9 @@ class SYMTAB_EXPORT Statement : public AnnotatableSparse, public Serializable
       {
       }
 	
-	std::string file_; // Maybe this should be module?
+	// Pooled, so the many statements of a file share one copy of its
+	// name and first stays valid when a statement is copied
+	InternedString file_; // Maybe this should be module?
 	unsigned int line_;
 	Offset start_addr_;
 	Offset end_addr_;
@@ -85,7 +100,7 @@ class SYMTAB_EXPORT Statement : public AnnotatableSparse, public Serializable
 
 	Offset startAddr() { return start_addr_;}
 	Offset endAddr() {return end_addr_;}
-	const std::string &getFile() { return file_;}
+	const std::string &getFile() { return file_.str();}
 	unsigned int getLine() {return line_;}
 	unsigned int getColumn() {return column;}
 
@@ -94,7 +109,7 @@ class SYMTAB_EXPORT Statement : public AnnotatableSparse, public Serializable
 	//  Does dyninst really need these?
 	void setLine(unsigned int l) {line_ = l;}
 	void setColumn(unsigned int l) {column = l;}
-	void setFile(const char * l) {file_ = std::string(l); first = file_.c_str();}
+	void setFile(const char * l) {file_ = InternedString(l); first = file_.c_str();}
 	void setStartAddr(Offset l) {start_addr_ = l;}
 	void setEndAddr(Offset l) {end_addr_ = l;}
 };
@@ -196,8 +211,8 @@ typedef Statement LineNoTuple;
    typeCollection* typeInfo_;
    
 
-   std::string fileName_;                   // short file 
-   std::string fullName_;                   // full path to file 
+   InternedString fileName_;                // short file 
+   InternedString fullName_;                // full path to file 
    supportedLanguages language_;
    Offset addr_;                      // starting address of module
    Symtab *exec_;
@@ -42,6 +42,7 @@
 ************************************************************************/
 
 #include "symutil.h"
+#include "InternedString.h"
 #include "Annotatable.h"
 #include "Serialization.h"
 #include <boost/shared_ptr.hpp>
@@ -181,6 +182,12 @@ class SYMTAB_EXPORT Symbol : public Serializable,
    std::string	 getPrettyName() const;
    std::string      getTypedName() const;
 
+   // The same names as pooled handles, which compare and hash as
+   // pointers; the symbol indexes of a Symtab are keyed by these
+   InternedString getInternedMangledName() const { return mangledName_; }
+   InternedString getInternedPrettyName() const;
+   InternedString getInternedTypedName() const;
+
    Module *getModule() const { return module_; } 
    Symtab *getSymtab() const;
    SymbolType getType () const { return type_; }
@@ -270,7 +277,15 @@ class SYMTAB_EXPORT Symbol : public Serializable,
 
    Aggregate *   aggregate_; // Pointer to Function or Variable container, if appropriate.
 
-   std::string mangledName_;
+   InternedString mangledName_;
+   // Filled in by demangleNames (see Symtab::demangleSymbol); until
+   // then the names are demangled on each request
+   InternedString prettyName_;
+   InternedString typedName_;
+   bool demangled_;
+
+   std::string demangleName(bool typed) const;
+   void demangleNames();
 
    SymbolTag     tag_;
    int index_;
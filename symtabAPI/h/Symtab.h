@@ -84,6 +84,8 @@ class relocationEntry;
 class Type;
 class FunctionBase;
 class FuncRange;
+class LineTable;
+struct AddressInfo;
 
 typedef IBSTree<FuncRange> FuncRangeLookup;
 typedef Dyninst::ProcessReader MemRegReader;
@@ -97,6 +99,7 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    friend class Function;
    friend class Variable;
    friend class Module;
+   friend class LineInformation;
    friend class Region;
    friend class emitElfStatic;
    friend class emitWin;
@@ -125,7 +128,18 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
                                       def_t defensive_binary = NotDefensive);
    static bool openFile(Symtab *&obj, void *mem_image, size_t size, 
                                       std::string name, def_t defensive_binary = NotDefensive);
+   // Opens every file in filenames concurrently on one bounded pool of
+   // num_threads workers (0 for one per hardware thread). objs[i] is the
+   // Symtab for filenames[i], or NULL if it failed to open; returns
+   // true only if every file opened.
+   static bool openFiles(std::vector<Symtab *> &objs,
+                         const std::vector<std::string> &filenames,
+                         def_t defensive_binary = NotDefensive,
+                         unsigned num_threads = 0);
    static Symtab *findOpenSymtab(std::string filename);
+   // Have openFile and openFiles save a SymtabSnapshot of each binary
+   // they open that doesn't have a current one. Off by default.
+   static void setSnapshotCache(bool enable);
    static bool closeSymtab(Symtab *);
 
    Serializable * serialize_impl(SerializerBase *sb, 
@@ -186,6 +200,11 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool getContainingFunction(Offset offset, Function* &func);
    //Searches for functions and returns inlined instances
    bool getContainingInlinedFunction(Offset offset, FunctionBase* &func);
+   //Symbolizes a batch of offsets at once: info[i] describes offsets[i].
+   // The offsets need not be sorted; they are visited in address order
+   // so the function and line indexes are each swept once.
+   bool getAddressInfo(const std::vector<Offset> &offsets,
+                       std::vector<AddressInfo> &info);
 
    // Variable
    bool findVariableByOffset(Variable *&ret, const Offset offset);
@@ -264,6 +283,10 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    void setTruncateLinePaths(bool value);
    bool getTruncateLinePaths();
    void forceFullLineInfoParse();
+   // Answer whole-binary line queries from a compact index of all the
+   // line information, saved to and mapped from a per-binary cache
+   // keyed by the build id. Off by default.
+   void setLineInfoCache(bool enable);
    
    /***** Type Information *****/
    virtual bool findType(Type *&type, std::string name);
@@ -279,6 +302,15 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    static std::vector<Type *> *getAllbuiltInTypes();
 
    void parseTypesNow();
+   // Parse only the type information for the code at addr, or
+   // for mod, where the debug format allows it
+   void parseTypesAt(Offset addr);
+   void parseModuleTypes(Module *mod);
+   // Number of threads parsing all type information at once may use;
+   // 1 (the default) parses serially, 0 uses one thread per hardware
+   // thread. The types found are the same either way.
+   void setTypeParseThreads(unsigned num_threads);
+   unsigned typeParseThreads() const;
 
    /***** Local Variable Information *****/
    bool findLocalVariable(std::vector<localVar *>&vars, std::string name);
@@ -392,12 +424,15 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
    // Parsing code
 
-   bool extractSymbolsFromFile(Object *linkedFile, std::vector<Symbol *> &raw_syms);
+   bool extractSymbolsFromFile(Object *linkedFile, std::vector<Symbol *> &raw_syms,
+                               std::vector<Symbol *> &undef_syms);
 
    bool fixSymRegion(Symbol *sym);
 
    bool fixSymModules(std::vector<Symbol *> &raw_syms);
    bool demangleSymbols(std::vector<Symbol *> &rawsyms);
+   class DemangleTask;
+   class OpenTask;
    bool createIndices(std::vector<Symbol *> &raw_syms, bool undefined);
    bool createAggregates();
 
@@ -534,9 +569,9 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    boost::multi_index_container<Symbol::Ptr, indexed_by <
    ordered_unique< tag<id>, const_mem_fun < Symbol::Ptr, Symbol*, &Symbol::Ptr::get> >,
    ordered_non_unique< tag<offset>, const_mem_fun < Symbol, Offset, &Symbol::getOffset > >,
-   hashed_non_unique< tag<mangled>, const_mem_fun < Symbol, std::string, &Symbol::getMangledName > >,
-   hashed_non_unique< tag<pretty>, const_mem_fun < Symbol, std::string, &Symbol::getPrettyName > >,
-   hashed_non_unique< tag<typed>, const_mem_fun < Symbol, std::string, &Symbol::getTypedName > >
+   hashed_non_unique< tag<mangled>, const_mem_fun < Symbol, InternedString, &Symbol::getInternedMangledName > >,
+   hashed_non_unique< tag<pretty>, const_mem_fun < Symbol, InternedString, &Symbol::getInternedPrettyName > >,
+   hashed_non_unique< tag<typed>, const_mem_fun < Symbol, InternedString, &Symbol::getInternedTypedName > >
    >
    > indexed_symbols;
    
@@ -572,6 +607,22 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
    //type info valid flag
    bool isTypeInfoValid_;
+   // set while parsing type info on demand
+   bool isTypeInfoParsing_;
+   unsigned typeParseThreads_;
+
+   // index of all line information, see setLineInfoCache
+   LineTable *getLineTable();
+   void invalidateLineTable();
+   LineTable *lineTable_;
+   bool lineInfoCache_;
+   // set once lines are added by hand; a saved table lacks them
+   bool lineInfoEdited_;
+   // set while lines are parsed from the debug information
+   bool lineInfoParsing_;
+   // called by LineInformation and Module whenever lines are added
+   void lineInfoChanged();
+   void parseLineInfoForAddr(Offset addr);
 
    int nlines_;
    unsigned long fdptr_;
@@ -593,6 +644,8 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool isDefensiveBinary_;
 
    FuncRangeLookup *func_lookup;
+   // the ranges in func_lookup, sorted by start
+   std::vector<FuncRange *> func_ranges_;
 
    //Don't use obj_private, use getObject() instead.
  public:
@@ -611,6 +664,22 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
     unsigned _ref_cnt;
 };
 
+/**
+ * What an address resolves to, see Symtab::getAddressInfo
+ **/
+struct AddressInfo {
+   AddressInfo() : symtab(NULL), offset(0), func(NULL) {}
+
+   Symtab *symtab;
+   Offset offset;
+   // as getContainingFunction
+   Function *func;
+   // innermost inlined instance first, as getContainingInlinedFunction,
+   // followed by each enclosing function out to the outermost
+   std::vector<FunctionBase *> inlines;
+   std::vector<LineNoTuple> lines;
+};
+
 /**
  * Used to represent something like a C++ try/catch block.  
  * Currently only used on Linux/x86
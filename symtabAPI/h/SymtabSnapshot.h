@@ -0,0 +1,179 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(_SymtabSnapshot_h_)
+#define _SymtabSnapshot_h_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "symutil.h"
+#include "Symbol.h"
+#include "Region.h"
+
+class MappedFile;
+
+namespace Dyninst{
+namespace SymtabAPI{
+
+class Symtab;
+
+/*
+ * A read-only image of the symbols, functions, modules and regions of
+ * a parsed Symtab, laid out so that it can be queried in place from a
+ * memory mapping.
+ *
+ * Records refer to each other and to their names by index, never by
+ * pointer, and the name indexes are stored as prebuilt hash tables, so
+ * opening a saved snapshot is a single mmap plus a check of its header;
+ * no Symtab is built and the binary is not read. This is meant for tools
+ * that need the symbols of many objects up front, such as symbolizers
+ * over every library of a process.
+ *
+ * Snapshots live with the other Dyninst caches ($DYNINST_CACHE_DIR, or
+ * $HOME/.dyninstAPI/caches/<platform>). They are named after the
+ * identity of the binary on disk (device, inode, size and modification
+ * time), so a rebuilt or replaced binary never finds a stale snapshot.
+ * Files that fail validation are removed. Symtab::openFile keeps them
+ * up to date when Symtab::setSnapshotCache is on.
+ */
+class SYMTAB_EXPORT SymtabSnapshot {
+ public:
+   static const unsigned NONE = 0xffffffff;
+
+   struct SymbolInfo {
+      const char *mangledName;
+      const char *prettyName;
+      const char *typedName;
+      Offset offset;
+      unsigned long size;
+      Symbol::SymbolType type;
+      Symbol::SymbolLinkage linkage;
+      Symbol::SymbolVisibility visibility;
+      unsigned region;     // index, or NONE
+      unsigned module;     // index, or NONE
+      bool isDynamic;
+      bool isAbsolute;
+      bool isDebug;
+      bool isUndefined;
+   };
+
+   struct FunctionInfo {
+      Offset offset;
+      unsigned long size;
+      unsigned symbol;     // index of the function's first symbol, or NONE
+      unsigned module;     // index, or NONE
+   };
+
+   struct ModuleInfo {
+      const char *fullName;
+      const char *fileName;
+      supportedLanguages language;
+      Offset addr;
+   };
+
+   struct RegionInfo {
+      const char *name;
+      Offset memOffset;
+      unsigned long memSize;
+      Offset diskOffset;
+      unsigned long diskSize;
+      Region::RegionType type;
+      Region::perm_t permissions;
+      bool isLoadable;
+      bool isTLS;
+   };
+
+   // Maps and validates the snapshot saved for the binary at file;
+   // NULL if there is none or it does not match the binary
+   static SymtabSnapshot *open(const std::string &file);
+
+   // Saves a snapshot of obj, which must have been opened from a file
+   static bool save(Symtab *obj);
+
+   ~SymtabSnapshot();
+
+   unsigned numSymbols() const { return (unsigned) nsymbols_; }
+   unsigned numFunctions() const { return (unsigned) nfuncs_; }
+   unsigned numModules() const { return (unsigned) nmodules_; }
+   unsigned numRegions() const { return (unsigned) nregions_; }
+
+   // Symbols are in address order, undefined symbols last
+   SymbolInfo symbol(unsigned i) const;
+   // Functions are in address order
+   FunctionInfo function(unsigned i) const;
+   ModuleInfo module(unsigned i) const;
+   RegionInfo region(unsigned i) const;
+
+   // Append the indices of the symbols with the given name
+   bool findSymbol(std::vector<unsigned> &ret, const std::string &name,
+                   NameType nameType = anyName) const;
+   // Append the indices of the defined symbols at offset
+   bool findSymbolByOffset(std::vector<unsigned> &ret, Offset offset) const;
+   // The function containing addr
+   bool findFunctionByAddress(Offset addr, unsigned &func) const;
+
+ private:
+   // the on-disk records; see SymtabSnapshot.C
+   struct symbol_rec;
+   struct func_rec;
+   struct module_rec;
+   struct region_rec;
+
+   SymtabSnapshot(MappedFile *mf);
+   bool validate(const std::string &key);
+   // the string at off, or "" if off is out of range
+   const char *str(uint32_t off) const;
+   void probe(const uint32_t *table, const std::string &name,
+              std::vector<unsigned> &ret) const;
+
+   MappedFile *mf_;
+   uint64_t nregions_;
+   uint64_t nmodules_;
+   uint64_t nsymbols_;
+   uint64_t ndefined_;
+   uint64_t nfuncs_;
+   uint64_t nbuckets_;
+   uint64_t nstrings_;
+   const region_rec *regions_;
+   const module_rec *modules_;
+   const symbol_rec *symbols_;
+   const func_rec *funcs_;
+   const uint32_t *by_mangled_;
+   const uint32_t *by_pretty_;
+   const uint32_t *by_typed_;
+   const char *strtab_;
+};
+
+}//namespace SymtabAPI
+}//namespace Dyninst
+
+#endif
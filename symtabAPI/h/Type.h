@@ -34,6 +34,7 @@
 #include "Serialization.h"
 #include "Annotatable.h"
 #include "symutil.h"
+#include "InternedString.h"
 
 namespace Dyninst{
 namespace SymtabAPI{
@@ -158,7 +159,7 @@ class SYMTAB_EXPORT Type : public Serializable, public  TYPE_ANNOTATABLE_CLASS
 
  protected:
    typeId_t ID_;           /* unique ID of type */
-   std::string name_;
+   InternedString name_;   /* pooled; the same names recur in every unit */
    unsigned int  size_;    /* size of type */
    dataClass   type_;
    
@@ -200,7 +201,7 @@ public:
    typeId_t getID() const;
    unsigned int getSize();
    bool setSize(unsigned int size);
-   std::string &getName();
+   const std::string &getName();
    bool setName(std::string);
    dataClass getDataClass() const;
 
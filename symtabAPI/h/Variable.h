@@ -83,7 +83,7 @@ class SYMTAB_EXPORT localVar : public Serializable, public AnnotatableSparse
 
 	std::string name_;
 	Type *type_;
-	std::string fileName_;
+	InternedString fileName_;
 	int lineNum_;
         FunctionBase *func_;
 	std::vector<VariableLocation> locs_;
@@ -117,7 +117,7 @@ class SYMTAB_EXPORT localVar : public Serializable, public AnnotatableSparse
 	Type *getType();
 	bool setType(Type *newType);
 	int  getLineNum();
-	std::string &getFileName();
+	const std::string &getFileName();
 	std::vector<VariableLocation> &getLocationLists();
 	bool operator==(const localVar &l);
 	Serializable *serialize_impl(SerializerBase *, 
@@ -0,0 +1,145 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _LINE_TABLE_H_
+#define _LINE_TABLE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "Module.h"
+
+class MappedFile;
+
+namespace Dyninst {
+namespace SymtabAPI {
+
+class Symtab;
+
+/*
+ * Flat, read-only index of all the line information of a binary.
+ *
+ * Every line range of every module is one entry: its start address in
+ * a sorted array, and a small fixed-size record holding the range's
+ * length and the ids of its file, line and column. An address is
+ * found with a binary search over the start addresses; a running
+ * maximum of the range ends bounds the walk back over ranges that
+ * start earlier but may still contain it. File names are kept once,
+ * in sorted order, and a second array of entries sorted by file and
+ * line answers file:line queries the same way; a built table only
+ * sorts it on the first such query.
+ *
+ * The arrays have the same layout in memory and on disk, so a table
+ * saved for a binary can be mapped and queried in place, without
+ * parsing its debug information again. Saved tables live with the
+ * other Dyninst caches ($DYNINST_CACHE_DIR, or
+ * $HOME/.dyninstAPI/caches/<platform>) and are named after the
+ * binary's build id; files that fail validation are removed.
+ */
+class LineTable {
+ public:
+    struct line_rec {
+        uint32_t length;    // of the address range
+        uint32_t file;      // index into the sorted file names
+        uint32_t line;
+        uint32_t column;
+    };
+
+    LineTable();
+    ~LineTable();
+
+    // index the current line information of mods
+    void build(const std::vector<Module *> & mods);
+
+    // map and validate the table saved under key, if there is one
+    bool load(const std::string & key);
+    // save a built table under key
+    bool save(const std::string & key) const;
+
+    // the key the table of obj is saved under, if it has a build id
+    static bool cacheKey(Symtab * obj, std::string & key);
+
+    uint64_t size() const { return _nlines; }
+
+    // appends in address order; false if nothing was found
+    bool getSourceLines(Offset addr, std::vector<LineNoTuple> & lines) const;
+    // the same, for a run of ascending addresses: pos carries the
+    // search position from one call to the next, so the run is a
+    // single forward sweep over the table
+    bool getSourceLines(Offset addr, std::vector<LineNoTuple> & lines,
+        uint64_t & pos) const;
+    bool getAddressRanges(const char * file, unsigned int line,
+        std::vector<std::pair<Offset, Offset> > & ranges) const;
+
+ private:
+    LineTable(const LineTable &);
+    LineTable & operator=(const LineTable &);
+
+    void reset();
+    void setArrays();
+    void internFiles();
+    bool findFile(const char * file, uint32_t & id) const;
+    // sorts _by_line, if it hasn't been; needs _by_line_lock
+    void sortByLine() const;
+    LineNoTuple statement(uint64_t i) const;
+    bool linesBefore(uint64_t i, Offset addr,
+        std::vector<LineNoTuple> & lines) const;
+
+    // storage for a built table; a loaded one is read from _mf
+    std::vector<uint64_t> _lows_v;
+    std::vector<uint64_t> _max_high_v;
+    std::vector<line_rec> _recs_v;
+    mutable std::vector<uint32_t> _by_line_v;
+    std::vector<uint32_t> _files_v;
+    std::string _strings_v;
+
+    MappedFile * _mf;
+    uint64_t _nlines;
+    uint64_t _nfiles;
+    uint64_t _nstrings;
+    const uint64_t * _lows;     // sorted range starts
+    const uint64_t * _max_high; // greatest range end up to each entry
+    const line_rec * _recs;
+    mutable const uint32_t * _by_line;  // entries sorted by file, line, address
+    mutable boost::mutex _by_line_lock;
+    const uint32_t * _files;    // string table offsets, sorted by name
+    const char * _strtab;
+
+    // pooled handles for the file names, so statements built from the
+    // table don't look the names up again
+    std::vector<InternedString> _file_names;
+};
+
+}
+}
+
+#endif
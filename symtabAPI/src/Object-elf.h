@@ -257,6 +257,7 @@ class stab_entry_64 : public stab_entry {
 // end of stab declarations
 
 class pdElfShdr;
+class DwarfWalker;
 class Symtab;
 class Region;
 class Object;
@@ -282,6 +283,10 @@ class Object;
   void parseFileLineInfo(Symtab *obj);
   
   void parseTypeInfo(Symtab *obj);
+  // Parse only the type information describing addr, or mod. These
+  // return false if the types can only be parsed all at once.
+  bool parseTypeInfoForAddr(Symtab *obj, Offset addr);
+  bool parseTypeInfoForModule(Symtab *obj, Module *mod);
 
   bool needs_function_binding() const { return (plt_addr_ > 0); } 
   bool get_func_binding_table(std::vector<relocationEntry> &fbt) const;
@@ -474,6 +479,9 @@ class Object;
   public:
   Dyninst::Dwarf::DwarfHandle::ptr dwarf;
   private:
+  // walker for types parsed on demand, until everything is parsed
+  DwarfWalker *typeWalker_;
+  DwarfWalker *typeWalker(Symtab *obj);
 
   bool      EEL;                 // true if EEL rewritten
   bool 	    did_open;		// true if the file has been mmapped
@@ -203,6 +203,8 @@ class Object : public AObject
     SYMTAB_EXPORT const char *interpreter_name() const { return NULL; }
     SYMTAB_EXPORT dyn_hash_map <std::string, LineInformation> &getLineInfo();
     SYMTAB_EXPORT void parseTypeInfo(Symtab *obj);
+    SYMTAB_EXPORT bool parseTypeInfoForAddr(Symtab *, Offset) { return false; }
+    SYMTAB_EXPORT bool parseTypeInfoForModule(Symtab *, Module *) { return false; }
     SYMTAB_EXPORT virtual Dyninst::Architecture getArch();   
     SYMTAB_EXPORT void    ParseGlobalSymbol(PSYMBOL_INFO pSymInfo);
     SYMTAB_EXPORT const std::vector<Offset> &getPossibleMains() const   { return possible_mains; }
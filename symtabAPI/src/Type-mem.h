@@ -36,7 +36,8 @@
 
 namespace Dyninst {
   namespace SymtabAPI {
-    extern std::map<void *, size_t> type_memory;
+    // size of the memory reserved for a placeholder type
+    size_t placeholderSize(void *mem);
   }
 }
 
@@ -47,8 +48,8 @@ template<class T>
 T *upgradePlaceholder(Type *placeholder, T *new_type)
 {
   void *mem = (void *) placeholder;
-  assert(type_memory.count(mem));
-  size_t size = type_memory[mem];
+  size_t size = placeholderSize(mem);
+  assert(size);
 
   assert(sizeof(T) < size);
   memset(mem, 0, size);
@@ -9,6 +9,7 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <map>
 #include "dyntypes.h"
 #include "VariableLocation.h"
 #include "Type.h"
@@ -177,10 +178,23 @@ namespace Dyninst {
             typedef
             std::vector<boost::shared_ptr<void> > FreeListT;
             FreeListT getFreeList();
-            bool parse();
-
-            // Takes current debug state as represented by dbg_;
-            bool parseModule(Dwarf_Bool is_info, Module *&fixUnknownMod);
+            // Parses every unit not parsed yet. With num_threads other
+            // than 1, the units of different modules are walked
+            // concurrently (0 uses one thread per hardware thread); the
+            // result is the same as parsing serially.
+            bool parse(unsigned num_threads = 1);
+
+            // Parsing on demand. The compilation units are indexed
+            // once, reading only their headers and root DIEs; a unit is
+            // then parsed when its code or module is asked about, and
+            // parse() walks only the units not parsed yet. Types
+            // referenced from another unit are parsed into the
+            // referencing module as they are found.
+            bool parseAt(Address addr);
+            bool parseModuleUnits(Module *m);
+
+            // Parses the unit rooted at moduleDIE
+            bool parseModule(Dwarf_Die moduleDIE, Module *&fixUnknownMod);
 
             // Non-recursive version of parse
             // A Context must be provided as an _input_ to this function,
@@ -223,7 +237,7 @@ namespace Dyninst {
             bool nameDefined() { return name_ != ""; }
             // These are invariant across a parse
 
-            std::vector<const char*> &srcFiles() { return srcFiles_; }
+            std::vector<InternedString> &srcFiles() { return srcFiles_; }
 
             // For functions and variables with a separate specification, a
             // pointer to that spec. For everyone else, this points to entry
@@ -307,8 +321,34 @@ namespace Dyninst {
 
             // Header-only functions get multiple parsed.
             std::set<FunctionBase *> parsedFuncs;
+
+            // Parallel parsing. Each thread walks whole modules with a
+            // walker and Dwarf_Debug of its own; libdwarf handles are not
+            // thread safe. Functions and variables are shared with other
+            // modules, so what a unit adds to them is staged, and merged
+            // into them in unit order once every thread is done.
+            class StagedFunction;
+            class GroupTask;
+            struct staged_var_t {
+                size_t unit;
+                Variable *var;
+                Type *type;
+            };
+            DwarfWalker(const DwarfWalker &master, Dwarf_Debug dbg);
+            bool parseParallel(unsigned num_threads, std::set<Module *> &mods, bool &ok);
+            bool parseGroup(const std::vector<size_t> &group);
+            void mergeStaged(std::vector<DwarfWalker *> &workers);
+            void mergeFunction(StagedFunction *sf);
+            void discardInlines(FunctionBase *f);
+            FunctionBase *realFunc(FunctionBase *f);
+
+            bool staging_;
+            size_t cur_unit_;
+            std::map<Function *, StagedFunction *> staged_by_func_;  // current module
+            std::vector<StagedFunction *> staged_funcs_;
+            std::vector<staged_var_t> staged_vars_;
         private:
-            std::vector<const char*> srcFiles_;
+            std::vector<InternedString> srcFiles_;
             char** srcFileList_;
 
             FreeListT freeList;
@@ -334,18 +374,66 @@ namespace Dyninst {
             Dwarf_Off compile_offset;
 
             // Type IDs are just int, but Dwarf_Off is 64-bit and may be relative to
-            // either .debug_info or .debug_types.
+            // either .debug_info or .debug_types. When both sections fit,
+            // the ID is computed from the offset, so it is the same
+            // whichever thread or order a DIE is parsed in; otherwise IDs
+            // are handed out in the order DIEs are seen.
+            bool offset_ids_;
+            Dwarf_Unsigned types_size_;   // extent of .debug_types
+            typeId_t id_limit_;           // above any offset-derived ID
             dyn_hash_map<Dwarf_Off, typeId_t> info_type_ids_; // .debug_info offset -> id
             dyn_hash_map<Dwarf_Off, typeId_t> types_type_ids_; // .debug_types offset -> id
             typeId_t get_type_id(Dwarf_Off offset, bool is_info);
             typeId_t type_id(); // get_type_id() for the current entry
+            bool type_offset(typeId_t id, Dwarf_Off &offset, Dwarf_Bool &is_info);
+            Dwarf_Unsigned sectionExtent(Dwarf_Bool is_info);
 
             // Map to connect DW_FORM_ref_sig8 to type IDs.
             dyn_hash_map<uint64_t, typeId_t> sig8_type_ids_;
             bool parseModuleSig8(Dwarf_Bool is_info);
-            void findAllSig8Types();
             bool findSig8Type(Dwarf_Sig8 *signature, Type *&type);
 
+            // The DIE each type ID was assigned for, without offset IDs
+            dyn_hash_map<typeId_t, std::pair<Dwarf_Off, Dwarf_Bool> > type_offsets_;
+
+            // Compilation unit index
+            struct unit_t {
+                Dwarf_Off die_offset;   // root DIE
+                Dwarf_Off header_offset;
+                Dwarf_Sig8 signature;
+                Dwarf_Bool is_info;
+                Dwarf_Half tag;
+                Dwarf_Half version;
+                Dwarf_Half addr_size;
+                Dwarf_Half offset_size;
+                Module *mod;
+                bool parsed;
+            };
+            struct unit_range_t {
+                Address low;
+                Address high;
+                Address max_high;       // over this and all lower ranges
+                size_t unit;
+                bool operator<(const unit_range_t &r) const { return low < r.low; }
+            };
+            std::vector<unit_t> units_;
+            std::vector<unit_range_t> unit_ranges_;  // sorted by low
+            std::vector<size_t> unranged_units_;     // code units without ranges
+            bool indexed_;
+            // placeholder types already looked for, per module
+            std::set<std::pair<Module *, typeId_t> > resolved_refs_;
+
+            bool findModuleName(Dwarf_Die moduleDIE, Dwarf_Half moduleTag,
+                                std::string &moduleName);
+            bool indexUnits();
+            void indexUnitRanges();
+            bool parseUnit(size_t i, Module *&fixUnknownMod);
+            void setUnitHeader(const unit_t &u);
+            bool findUnit(Dwarf_Off offset, Dwarf_Bool is_info, size_t &unit);
+            void finishModules(const std::set<Module *> &mods, bool resolve);
+            void keepModuleTypes(Module *m);
+            void resolveTypeRefs(Module *m);
+
         protected:
             virtual void setFuncReturnType();
 
@@ -357,6 +445,8 @@ namespace Dyninst {
 
             virtual void setFuncFromLowest(Address lowest);
 
+            virtual std::vector<VariableLocation>& getFramePtrRefForInit();
+
             virtual void createParameter(const std::vector<VariableLocation> &locs, Type *paramType, Dwarf_Unsigned lineNo,
                          const std::string &fileName);
 